@@ -0,0 +1,479 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Benchmarks of the functions that process whole arrays.
+ *
+ * The time is given per element (or per sample, or per point of a transform).
+ */
+
+#include <math.h>
+#include <string.h>
+#include "fixed_point/array.h"
+#include "fixed_point/cordic.h"
+#include "fixed_point/divide.h"
+#include "fixed_point/fft.h"
+#include "fixed_point/filter.h"
+#include "fixed_point/quaternion.h"
+#include "fixed_point/soa.h"
+#include "fixed_point/sqrt.h"
+#include "fixed_point/trig.h"
+#include "bench.h"
+
+#define PI_F 3.14159265f
+#define N BENCH_LEN
+
+#define FIR_TAPS 32
+#define BIQUAD_STAGES 2
+#define BIQUAD_CHANNELS 16
+
+typedef struct {
+	float re, im;
+} fcomplex;
+
+static cfrac cx[N], cx_in[N];
+static cfrac fft_tw[FFT_TWIDDLE_LEN(N)], rfft_tw[RFFT_TWIDDLE_LEN(N)];
+static fft_f fft_plan;
+static rfft_f rfft_plan;
+static fcomplex fcx[N], fcx_in[N], fft_tw_fl[N / 2];
+
+static frac fir_coef[FIR_TAPS], fir_state[FIR_STATE_LEN(FIR_TAPS)];
+static fir_f fir_filter;
+static float fir_coef_fl[FIR_TAPS], fir_in_fl[N + FIR_TAPS];
+
+static biquad_coef bq_coef[BIQUAD_STAGES];
+static dfrac bq_state[BIQUAD_STATE_LEN(BIQUAD_STAGES, 1)];
+static dfrac bq_state_mc[BIQUAD_STATE_LEN(BIQUAD_STAGES, BIQUAD_CHANNELS)];
+static biquad_f bq_filter, bq_filter_mc;
+static float bq_coef_fl[BIQUAD_STAGES][5];
+static float bq_state_fl[BIQUAD_STAGES][2];
+
+static frac vs_buf[3][FXP_SOA_LEN(frac, N)];
+static dfrac dvs_buf[FXP_SOA_LEN(dfrac, N)];
+static frac qs_buf[FXP_SOA_QLEN(frac, N)];
+static vec3_soa vs_x, vs_y, vs_r;
+static dvec3_soa dvs_x;
+static quat_soa qs_r;
+
+/* Butterworth low pass, cutoff at fs/10: b0, b1, b2, a1, a2 */
+static const float bq_design[5] = {
+	0.0674553f, 0.1349105f, 0.0674553f, -1.1429805f, 0.4128016f
+};
+
+/* ########################## Float references ############################## */
+
+static void fft_float(fcomplex *x)
+{
+	size_t i, j, len;
+
+	for (i = 1, j = 0; i < N; i++) {
+		size_t bit = N >> 1;
+
+		for (; j & bit; bit >>= 1)
+			j ^= bit;
+		j |= bit;
+		if (i < j) {
+			fcomplex t = x[i];
+			x[i] = x[j];
+			x[j] = t;
+		}
+	}
+
+	for (len = 2; len <= N; len *= 2) {
+		size_t step = N / len;
+
+		for (i = 0; i < N; i += len) {
+			for (j = 0; j < len / 2; j++) {
+				fcomplex w = fft_tw_fl[j * step];
+				fcomplex *a = &x[i + j], *b = &x[i + j + len/2];
+				fcomplex t;
+
+				t.re = b->re * w.re - b->im * w.im;
+				t.im = b->re * w.im + b->im * w.re;
+				b->re = a->re - t.re;
+				b->im = a->im - t.im;
+				a->re += t.re;
+				a->im += t.im;
+			}
+		}
+	}
+}
+
+static float fir_float(const float *x)
+{
+	float acc = 0;
+	size_t k;
+
+	for (k = 0; k < FIR_TAPS; k++)
+		acc += fir_coef_fl[k] * x[FIR_TAPS - 1 - k];
+
+	return acc;
+}
+
+static float biquad_float(float x)
+{
+	size_t s;
+
+	for (s = 0; s < BIQUAD_STAGES; s++) {
+		const float *c = bq_coef_fl[s];
+		float *z = bq_state_fl[s];
+		float y = c[0]*x + z[0];
+
+		z[0] = c[1]*x - c[3]*y + z[1];
+		z[1] = c[2]*x - c[4]*y;
+		x = y;
+	}
+
+	return x;
+}
+
+void bench_batch_init(void)
+{
+	size_t i;
+
+	for (i = 0; i < N; i++) {
+		cx_in[i].re = f_x[i];
+		cx_in[i].im = f_y[i];
+		fcx_in[i].re = fl_x[i];
+		fcx_in[i].im = fl_y[i];
+	}
+	for (i = 0; i < N / 2; i++) {
+		fft_tw_fl[i].re = cosf(2 * PI_F * i / N);
+		fft_tw_fl[i].im = -sinf(2 * PI_F * i / N);
+	}
+	fft_init(&fft_plan, fft_tw, N);
+	rfft_init(&rfft_plan, rfft_tw, N);
+
+	for (i = 0; i < FIR_TAPS; i++) {
+		fir_coef[i].v = f_y[i].v / FIR_TAPS;
+		fir_coef_fl[i] = F_TO_FLOAT(fir_coef[i]);
+	}
+	for (i = 0; i < N + FIR_TAPS; i++)
+		fir_in_fl[i] = fl_x[i % N];
+	fir_init(&fir_filter, fir_coef, fir_state, FIR_TAPS);
+
+	for (i = 0; i < BIQUAD_STAGES; i++) {
+		size_t k;
+
+		for (k = 0; k < 5; k++)
+			bq_coef_fl[i][k] = bq_design[k];
+		bq_coef[i].b0 = REAL_TO_F(bq_design[0] / 2);
+		bq_coef[i].b1 = REAL_TO_F(bq_design[1] / 2);
+		bq_coef[i].b2 = REAL_TO_F(bq_design[2] / 2);
+		bq_coef[i].a1 = REAL_TO_F(bq_design[3] / 2);
+		bq_coef[i].a2 = REAL_TO_F(bq_design[4] / 2);
+	}
+	biquad_init(&bq_filter, bq_coef, bq_state, BIQUAD_STAGES, 1, 1);
+	biquad_init(&bq_filter_mc, bq_coef, bq_state_mc, BIQUAD_STAGES,
+		    BIQUAD_CHANNELS, 1);
+
+	vec3_soa_init(&vs_x, vs_buf[0], N);
+	vec3_soa_init(&vs_y, vs_buf[1], N);
+	vec3_soa_init(&vs_r, vs_buf[2], N);
+	dvec3_soa_init(&dvs_x, dvs_buf, N);
+	quat_soa_init(&qs_r, qs_buf, N);
+	for (i = 0; i < N; i++) {
+		vs_x.x[i] = v_x[i].x;
+		vs_x.y[i] = v_x[i].y;
+		vs_x.z[i] = v_x[i].z;
+		vs_y.x[i] = v_y[i].x;
+		vs_y.y[i] = v_y[i].y;
+		vs_y.z[i] = v_y[i].z;
+		dvs_x.x[i] = dv_x[i].x;
+		dvs_x.y[i] = dv_x[i].y;
+		dvs_x.z[i] = dv_x[i].z;
+	}
+}
+
+/* ############################ Array routines ############################## */
+
+BENCH_N(f_add_n, f_add_n(f_r, f_x, f_y, N), fl_r[i] = fl_x[i] + fl_y[i])
+BENCH_N(f_sub_n, f_sub_n(f_r, f_x, f_y, N), fl_r[i] = fl_x[i] - fl_y[i])
+BENCH_N(df_add_n, df_add_n(d_r, d_x, d_y, N), fl_r[i] = fl_x[i] + fl_y[i])
+BENCH_N(df_sub_n, df_sub_n(d_r, d_x, d_y, N), fl_r[i] = fl_x[i] - fl_y[i])
+BENCH_N(ef_add_n, ef_add_n(e_r, e_x, e_y, N), fl_r[i] = fl_x[i] + fl_y[i])
+BENCH_N(ef_sub_n, ef_sub_n(e_r, e_x, e_y, N), fl_r[i] = fl_x[i] - fl_y[i])
+BENCH_N(ef_f_add_n, ef_f_add_n(e_r, e_x, f_y, N),
+	fl_r[i] = fl_x[i] + fl_y[i])
+BENCH_N(f_neg_n, f_neg_n(f_r, f_x, N), fl_r[i] = -fl_x[i])
+BENCH_N(df_neg_n, df_neg_n(d_r, d_x, N), fl_r[i] = -fl_x[i])
+BENCH_N(ef_neg_n, ef_neg_n(e_r, e_x, N), fl_r[i] = -fl_x[i])
+BENCH_N(f_mul_n, f_mul_n(f_r, f_x, f_y, N), fl_r[i] = fl_x[i] * fl_y[i])
+BENCH_N(f_mul_r_n, f_mul_r_n(f_r, f_x, f_y, N), fl_r[i] = fl_x[i] * fl_y[i])
+BENCH_N(f_mul_cr_n, f_mul_cr_n(f_r, f_x, f_y, N),
+	fl_r[i] = fl_x[i] * fl_y[i])
+BENCH_N(f_mul_df_n, f_mul_df_n(d_r, f_x, f_y, N),
+	fl_r[i] = fl_x[i] * fl_y[i])
+BENCH_N(f_mf_mul_ef_n, f_mf_mul_ef_n(e_r, f_x, m_x, N),
+	fl_r[i] = fl_x[i] * fl_y[i])
+BENCH_N(f_imul_n, f_imul_n(f_r, f_x, 3, N), fl_r[i] = fl_x[i] * 3)
+BENCH_N(f_imul_i_n, f_imul_i_n(i_r, f_x, 3, N), i_r[i] = (int)(fl_x[i] * 3))
+BENCH_N(f_imul_ef_n, f_imul_ef_n(e_r, f_x, 3, N), fl_r[i] = fl_x[i] * 3)
+BENCH_N(df_imul_n, df_imul_n(d_r, d_x, 3, N), fl_r[i] = fl_x[i] * 3)
+BENCH_N(ef_imul_n, ef_imul_n(e_r, e_x, 3, N), fl_r[i] = fl_x[i] * 3)
+BENCH_N(f_idiv_n, f_idiv_n(f_r, f_x, 7, N), fl_r[i] = fl_x[i] / 7)
+BENCH_N(df_idiv_n, df_idiv_n(d_r, d_x, 7, N), fl_r[i] = fl_x[i] / 7)
+BENCH_N(ef_idiv_n, ef_idiv_n(e_r, e_x, 7, N), fl_r[i] = fl_x[i] / 7)
+BENCH_N(f_idivd_n, f_idivd_n(f_r, f_x, &div_x, N), fl_r[i] = fl_x[i] / 7)
+BENCH_N(df_idivd_n, df_idivd_n(d_r, d_x, &div_x, N), fl_r[i] = fl_x[i] / 7)
+BENCH_N(ef_idivd_n, ef_idivd_n(e_r, e_x, &div_x, N), fl_r[i] = fl_x[i] / 7)
+BENCH_N(v_idivd_n, v_idivd_n(v_r, v_x, &div_x, N),
+	(fv_r[i].x = fv_x[i].x / 7, fv_r[i].y = fv_x[i].y / 7,
+	 fv_r[i].z = fv_x[i].z / 7))
+BENCH_N(dv_idivd_n, dv_idivd_n(dv_r, dv_x, &div_x, N),
+	(fv_r[i].x = fv_x[i].x / 7, fv_r[i].y = fv_x[i].y / 7,
+	 fv_r[i].z = fv_x[i].z / 7))
+BENCH_N(ev_idivd_n, ev_idivd_n(ev_r, ev_x, &div_x, N),
+	(fv_r[i].x = fv_x[i].x / 7, fv_r[i].y = fv_x[i].y / 7,
+	 fv_r[i].z = fv_x[i].z / 7))
+BENCH_N(df_shiftl_n, df_shiftl_n(d_r, d_x, 3, N), fl_r[i] = fl_x[i] * 8)
+BENCH_N(df_shiftr_n, df_shiftr_n(d_r, d_x, 3, N), fl_r[i] = fl_x[i] / 8)
+BENCH_N_ONLY(df_to_f_n, df_to_f_n(f_r, d_x, N))
+BENCH_N_ONLY(df_to_f_r_n, df_to_f_r_n(f_r, d_x, N))
+BENCH_N_ONLY(df_to_f_cr_n, df_to_f_cr_n(f_r, d_x, N))
+BENCH_N_ONLY(f_to_df_n, f_to_df_n(d_r, f_x, N))
+BENCH_N_ONLY(f_to_ef_n, f_to_ef_n(e_r, f_x, N))
+BENCH_N_ONLY(ef_to_f_n, ef_to_f_n(f_r, e_x, N))
+BENCH_N(f_ef_div_n, f_ef_div_n(e_r, f_x, e_y, N),
+	fl_r[i] = fl_x[i] / fl_y[i])
+BENCH_N(f_clip_n, f_clip_n(f_r, f_x, _frac(FRAC_1_V / 2), N),
+	fl_r[i] = clipf(fl_x[i], 0.5f))
+BENCH_N(df_addsat_n, df_addsat_n(d_r, d_x, d_y, N),
+	fl_r[i] = fl_x[i] + fl_y[i])
+BENCH_N(df_subsat_n, df_subsat_n(d_r, d_x, d_y, N),
+	fl_r[i] = fl_x[i] - fl_y[i])
+BENCH_N(ef_addsat_n, ef_addsat_n(e_r, e_x, e_y, N),
+	fl_r[i] = fl_x[i] + fl_y[i])
+BENCH_N(ef_subsat_n, ef_subsat_n(e_r, e_x, e_y, N),
+	fl_r[i] = fl_x[i] - fl_y[i])
+BENCH_N(f_addsat_n, f_addsat_n(f_r, f_x, f_y, N),
+	fl_r[i] = fl_x[i] + fl_y[i])
+BENCH_N(f_subsat_n, f_subsat_n(f_r, f_x, f_y, N),
+	fl_r[i] = fl_x[i] - fl_y[i])
+BENCH_N(f_negsat_n, f_negsat_n(f_r, f_x, N), fl_r[i] = -fl_x[i])
+BENCH_N(f_mulsat_n, f_mulsat_n(f_r, f_x, f_y, N),
+	fl_r[i] = fl_x[i] * fl_y[i])
+BENCH_N(f_macs_df_n, f_macs_df_n(d_r, f_x, f_y, N),
+	fl_r[i] = fl_x[i] * fl_y[i] + fl_r[i])
+BENCH_N(f_dot_df, d_r[0] = f_dot_df(f_x, f_y, N),
+	fl_r[0] += fl_x[i] * fl_y[i])
+BENCH_N(f_dot_macs_df, d_r[0] = f_dot_macs_df(d_x[0], f_x, f_y, N),
+	fl_r[0] += fl_x[i] * fl_y[i])
+BENCH_N(f_dot_lf, l_r[0] = f_dot_lf(f_x, f_y, N),
+	fl_r[0] += fl_x[i] * fl_y[i])
+BENCH_N(f_dot_mac_lf, l_r[0] = f_dot_mac_lf(l_x[0], f_x, f_y, N),
+	fl_r[0] += fl_x[i] * fl_y[i])
+BENCH_N(df_sum_lf, l_r[0] = df_sum_lf(d_x, N), fl_r[0] += fl_x[i])
+BENCH_N_ONLY(float_to_f_n, float_to_f_n(f_r, fl_x, N))
+BENCH_N_ONLY(float_to_df_n, float_to_df_n(d_r, fl_x, N))
+BENCH_N_ONLY(float_to_ef_n, float_to_ef_n(e_r, fl_x, N))
+BENCH_N_ONLY(double_to_f_n, double_to_f_n(f_r, db_x, N))
+BENCH_N_ONLY(double_to_df_n, double_to_df_n(d_r, db_x, N))
+BENCH_N_ONLY(double_to_ef_n, double_to_ef_n(e_r, db_x, N))
+BENCH_N_ONLY(f_to_float_n, f_to_float_n(fl_r, f_x, N))
+BENCH_N_ONLY(df_to_float_n, df_to_float_n(fl_r, d_x, N))
+BENCH_N_ONLY(ef_to_float_n, ef_to_float_n(fl_r, e_x, N))
+BENCH_N_ONLY(f_to_double_n, f_to_double_n(db_r, f_x, N))
+BENCH_N_ONLY(df_to_double_n, df_to_double_n(db_r, d_x, N))
+BENCH_N_ONLY(ef_to_double_n, ef_to_double_n(db_r, e_x, N))
+
+/* ######################### Other array routines ########################### */
+
+BENCH_N(f_div_n, f_div_n(f_r, f_x, f_y, N), fl_r[i] = fl_x[i] / fl_y[i])
+BENCH_N(df_div_n, df_div_n(d_r, d_x, d_y, N), fl_r[i] = fl_x[i] / fl_y[i])
+BENCH_N(ef_div_n, ef_div_n(e_r, e_x, e_y, N), fl_r[i] = fl_x[i] / fl_y[i])
+BENCH_N(f_recip_n, f_recip_n(e_r, f_x, N), fl_r[i] = 1.0f / fl_x[i])
+BENCH_N(f_sqrt_n, f_sqrt_n(f_r, f_x, N), fl_r[i] = sqrtf(fl_x[i]))
+BENCH_N(df_sqrt_n, df_sqrt_n(d_r, d_x, N), fl_r[i] = sqrtf(fl_x[i]))
+BENCH_N(ef_sqrt_n, ef_sqrt_n(e_r, e_x, N), fl_r[i] = sqrtf(fl_x[i]))
+BENCH_N(df_rsqrt_n, df_rsqrt_n(d_r, d_x, N),
+	fl_r[i] = 1.0f / sqrtf(fl_x[i]))
+BENCH_N(f_sin_n, f_sin_n(f_r, f_x, N), fl_r[i] = sinf(fl_x[i] * PI_F))
+BENCH_N(f_cos_n, f_cos_n(f_r, f_x, N), fl_r[i] = cosf(fl_x[i] * PI_F))
+BENCH_N(f_sincos_n, f_sincos_n(f_r, f_s, f_x, N),
+	(fl_r[i] = sinf(fl_x[i] * PI_F), fl_s[i] = cosf(fl_x[i] * PI_F)))
+BENCH_N(f_atan2_n, f_atan2_n(f_r, f_x, f_y, N),
+	fl_r[i] = atan2f(fl_x[i], fl_y[i]))
+BENCH_N(f_hypot_n, f_hypot_n(f_r, f_x, f_y, N),
+	fl_r[i] = hypotf(fl_x[i], fl_y[i]))
+BENCH_N(f_to_polar_n, f_to_polar_n(f_r, f_s, f_x, f_y, N),
+	(fl_r[i] = hypotf(fl_x[i], fl_y[i]),
+	 fl_s[i] = atan2f(fl_y[i], fl_x[i])))
+BENCH_N(f_from_polar_n, f_from_polar_n(f_r, f_s, f_x, f_y, N),
+	(fl_r[i] = fl_x[i] * cosf(fl_y[i] * PI_F),
+	 fl_s[i] = fl_x[i] * sinf(fl_y[i] * PI_F)))
+BENCH_N_ONLY(f_rotate_n, f_rotate_n(f_r, f_s, f_x, N))
+BENCH_N_ONLY(q_normalize_n, q_normalize_n(q_r, q_x, N))
+BENCH_N_ONLY(dq_normalize_n, dq_normalize_n(dq_r, dq_x, N))
+BENCH_N_ONLY(q_rot_n, q_rot_n(v_r, q_x[0], v_x, N))
+BENCH_N(v_dot_df_n, v_dot_df_n(d_r, v_x, v_y, N),
+	fl_r[i] = fv_x[i].x * fv_y[i].x + fv_x[i].y * fv_y[i].y
+		  + fv_x[i].z * fv_y[i].z)
+BENCH_N(v_cross_n, v_cross_n(v_r, v_x, v_y, N),
+	(fv_r[i].x = fv_x[i].y * fv_y[i].z - fv_x[i].z * fv_y[i].y,
+	 fv_r[i].y = fv_x[i].z * fv_y[i].x - fv_x[i].x * fv_y[i].z,
+	 fv_r[i].z = fv_x[i].x * fv_y[i].y - fv_x[i].y * fv_y[i].x))
+BENCH_N(v_norm_n, v_norm_n(f_r, v_x, N),
+	fl_r[i] = sqrtf(fv_x[i].x * fv_x[i].x + fv_x[i].y * fv_x[i].y
+			+ fv_x[i].z * fv_x[i].z))
+
+/* ######################## Structure-of-arrays vectors ##################### */
+
+BENCH_N(v_add_soa, v_add_soa(vs_r, vs_x, vs_y, N),
+	(fv_r[i].x = fv_x[i].x + fv_y[i].x, fv_r[i].y = fv_x[i].y + fv_y[i].y,
+	 fv_r[i].z = fv_x[i].z + fv_y[i].z))
+BENCH_N(v_fmul_soa, v_fmul_soa(vs_r, vs_x, f_y[0], N),
+	(fv_r[i].x = fv_x[i].x * fl_y[0], fv_r[i].y = fv_x[i].y * fl_y[0],
+	 fv_r[i].z = fv_x[i].z * fl_y[0]))
+BENCH_N_ONLY(dv_to_v_soa, dv_to_v_soa(vs_r, dvs_x, N))
+BENCH_N_ONLY(v_to_soa, v_to_soa(vs_r, v_x, N))
+BENCH_N_ONLY(v_from_soa, v_from_soa(v_r, vs_x, N))
+BENCH_N_ONLY(q_to_soa, q_to_soa(qs_r, q_x, N))
+BENCH_N_ONLY(q_from_soa, q_from_soa(q_r, qs_r, N))
+BENCH_N_ONLY(q_rot_soa, q_rot_soa(vs_r, q_x[0], vs_x, N))
+
+/* ######################## Transforms and filters ########################## */
+
+/* The input is restored before every transform, in both versions */
+BENCH_CALL(bench_fft, (memcpy(cx, cx_in, sizeof(cx)), fft(&fft_plan, cx)))
+BENCH_CALL(real_fft, (memcpy(fcx, fcx_in, sizeof(fcx)), fft_float(fcx)))
+BENCH_CALL(bench_ifft, (memcpy(cx, cx_in, sizeof(cx)), ifft(&fft_plan, cx)))
+BENCH_N_ONLY(rfft, rfft(&rfft_plan, cx, f_x))
+BENCH_N(fir_process, fir_process(&fir_filter, f_r, f_x, N),
+	fl_r[i] = fir_float(&fir_in_fl[i]))
+BENCH_N(biquad_process, biquad_process(&bq_filter, f_r, f_x, N),
+	fl_r[i] = biquad_float(fl_x[i]))
+BENCH_N_ONLY(biquad_process_mc, biquad_process(&bq_filter_mc, f_r, f_x,
+					       N / BIQUAD_CHANNELS))
+
+const struct bench bench_batch[] = {
+	BENCH_ENTRY(f_add_n),
+	BENCH_ENTRY(f_sub_n),
+	BENCH_ENTRY(df_add_n),
+	BENCH_ENTRY(df_sub_n),
+	BENCH_ENTRY(ef_add_n),
+	BENCH_ENTRY(ef_sub_n),
+	BENCH_ENTRY(ef_f_add_n),
+	BENCH_ENTRY(f_neg_n),
+	BENCH_ENTRY(df_neg_n),
+	BENCH_ENTRY(ef_neg_n),
+	BENCH_ENTRY(f_mul_n),
+	BENCH_ENTRY(f_mul_r_n),
+	BENCH_ENTRY(f_mul_cr_n),
+	BENCH_ENTRY(f_mul_df_n),
+	BENCH_ENTRY(f_mf_mul_ef_n),
+	BENCH_ENTRY(f_imul_n),
+	BENCH_ENTRY(f_imul_i_n),
+	BENCH_ENTRY(f_imul_ef_n),
+	BENCH_ENTRY(df_imul_n),
+	BENCH_ENTRY(ef_imul_n),
+	BENCH_ENTRY(f_idiv_n),
+	BENCH_ENTRY(df_idiv_n),
+	BENCH_ENTRY(ef_idiv_n),
+	BENCH_ENTRY(f_idivd_n),
+	BENCH_ENTRY(df_idivd_n),
+	BENCH_ENTRY(ef_idivd_n),
+	BENCH_ENTRY(v_idivd_n),
+	BENCH_ENTRY(dv_idivd_n),
+	BENCH_ENTRY(ev_idivd_n),
+	BENCH_ENTRY(df_shiftl_n),
+	BENCH_ENTRY(df_shiftr_n),
+	BENCH_ENTRY_ONLY(df_to_f_n),
+	BENCH_ENTRY_ONLY(df_to_f_r_n),
+	BENCH_ENTRY_ONLY(df_to_f_cr_n),
+	BENCH_ENTRY_ONLY(f_to_df_n),
+	BENCH_ENTRY_ONLY(f_to_ef_n),
+	BENCH_ENTRY_ONLY(ef_to_f_n),
+	BENCH_ENTRY(f_ef_div_n),
+	BENCH_ENTRY(f_clip_n),
+	BENCH_ENTRY(df_addsat_n),
+	BENCH_ENTRY(df_subsat_n),
+	BENCH_ENTRY(ef_addsat_n),
+	BENCH_ENTRY(ef_subsat_n),
+	BENCH_ENTRY(f_addsat_n),
+	BENCH_ENTRY(f_subsat_n),
+	BENCH_ENTRY(f_negsat_n),
+	BENCH_ENTRY(f_mulsat_n),
+	BENCH_ENTRY(f_macs_df_n),
+	BENCH_ENTRY(f_dot_df),
+	BENCH_ENTRY(f_dot_macs_df),
+	BENCH_ENTRY(f_dot_lf),
+	BENCH_ENTRY(f_dot_mac_lf),
+	BENCH_ENTRY(df_sum_lf),
+	BENCH_ENTRY_ONLY(float_to_f_n),
+	BENCH_ENTRY_ONLY(float_to_df_n),
+	BENCH_ENTRY_ONLY(float_to_ef_n),
+	BENCH_ENTRY_ONLY(double_to_f_n),
+	BENCH_ENTRY_ONLY(double_to_df_n),
+	BENCH_ENTRY_ONLY(double_to_ef_n),
+	BENCH_ENTRY_ONLY(f_to_float_n),
+	BENCH_ENTRY_ONLY(df_to_float_n),
+	BENCH_ENTRY_ONLY(ef_to_float_n),
+	BENCH_ENTRY_ONLY(f_to_double_n),
+	BENCH_ENTRY_ONLY(df_to_double_n),
+	BENCH_ENTRY_ONLY(ef_to_double_n),
+	BENCH_ENTRY(f_div_n),
+	BENCH_ENTRY(df_div_n),
+	BENCH_ENTRY(ef_div_n),
+	BENCH_ENTRY(f_recip_n),
+	BENCH_ENTRY(f_sqrt_n),
+	BENCH_ENTRY(df_sqrt_n),
+	BENCH_ENTRY(ef_sqrt_n),
+	BENCH_ENTRY(df_rsqrt_n),
+	BENCH_ENTRY(f_sin_n),
+	BENCH_ENTRY(f_cos_n),
+	BENCH_ENTRY(f_sincos_n),
+	BENCH_ENTRY(f_atan2_n),
+	BENCH_ENTRY(f_hypot_n),
+	BENCH_ENTRY(f_to_polar_n),
+	BENCH_ENTRY(f_from_polar_n),
+	BENCH_ENTRY_ONLY(f_rotate_n),
+	BENCH_ENTRY_ONLY(q_normalize_n),
+	BENCH_ENTRY_ONLY(dq_normalize_n),
+	BENCH_ENTRY_ONLY(q_rot_n),
+	BENCH_ENTRY(v_dot_df_n),
+	BENCH_ENTRY(v_cross_n),
+	BENCH_ENTRY(v_norm_n),
+	BENCH_ENTRY(v_add_soa),
+	BENCH_ENTRY(v_fmul_soa),
+	BENCH_ENTRY_ONLY(dv_to_v_soa),
+	BENCH_ENTRY_ONLY(v_to_soa),
+	BENCH_ENTRY_ONLY(v_from_soa),
+	BENCH_ENTRY_ONLY(q_to_soa),
+	BENCH_ENTRY_ONLY(q_from_soa),
+	BENCH_ENTRY_ONLY(q_rot_soa),
+	BENCH_ENTRY(fft),
+	BENCH_ENTRY_ONLY(ifft),
+	BENCH_ENTRY_ONLY(rfft),
+	BENCH_ENTRY(fir_process),
+	BENCH_ENTRY(biquad_process),
+	BENCH_ENTRY_ONLY(biquad_process_mc),
+	BENCH_END
+};
@@ -0,0 +1,406 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Micro-benchmark driver.
+ *
+ * Usage: bench [-o output.json] [-b baseline.json] [-t tolerance] [-f filter]
+ *              [-i isa]
+ *
+ * Every benchmark is run several times and the fastest run is reported, in
+ * nanoseconds and in cycles (of the time stamp counter, where available) per
+ * element. If a baseline produced by a previous run is given, the benchmarks
+ * which got slower by more than the tolerance (in percent) are reported and
+ * the program exits with status 1.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "fixed_point/dispatch.h"
+#include "bench.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define HAVE_TSC
+#endif
+
+/** Each run is made long enough to take at least this time. */
+#define MIN_RUN_NS 1e6
+
+/** Number of timed runs. */
+#define RUNS 11
+
+#define NAME_LEN 64
+
+struct timing {
+	double ns;		/* Per element */
+	double cycles;		/* Per element, NAN if not available */
+};
+
+struct group {
+	const char *name;
+	const struct bench *table;
+};
+
+static const struct group groups[] = {
+	{"scalar", bench_scalar},
+	{"vector", bench_vector},
+	{"quaternion", bench_quaternion},
+	{"matrix", bench_matrix},
+	{"batch", bench_batch},
+};
+
+#define N_GROUPS (sizeof(groups) / sizeof(groups[0]))
+
+struct baseline_entry {
+	char group[NAME_LEN];
+	char name[NAME_LEN];
+	double ns;
+};
+
+static struct baseline_entry *baseline;
+static size_t baseline_len, baseline_cap;
+
+/* ############################### Timing ################################### */
+
+static double now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static double now_cycles(void)
+{
+#ifdef HAVE_TSC
+	return (double)__rdtsc();
+#else
+	return NAN;
+#endif
+}
+
+static struct timing measure(bench_fn fn)
+{
+	struct timing best = {HUGE_VAL, HUGE_VAL};
+	size_t reps = 1;
+	int k;
+
+	/* Warm up and find the number of repetitions */
+	for (;;) {
+		double t0 = now_ns();
+
+		fn(reps);
+		if (now_ns() - t0 >= MIN_RUN_NS)
+			break;
+		reps *= 2;
+	}
+
+	for (k = 0; k < RUNS; k++) {
+		double t0, t1, c0, c1;
+
+		t0 = now_ns();
+		c0 = now_cycles();
+		fn(reps);
+		c1 = now_cycles();
+		t1 = now_ns();
+
+		best.ns = fmin(best.ns, (t1 - t0) / ((double)reps * BENCH_LEN));
+		best.cycles = fmin(best.cycles,
+				   (c1 - c0) / ((double)reps * BENCH_LEN));
+	}
+
+	return best;
+}
+
+/* ########################### Baseline handling ############################ */
+
+/* Find the string value of "key" in a line of JSON. */
+static int json_string(const char *line, const char *key, char *out)
+{
+	char pattern[NAME_LEN + 8];
+	const char *p, *end;
+
+	sprintf(pattern, "\"%s\": \"", key);
+	p = strstr(line, pattern);
+	if (p == NULL)
+		return -1;
+	p += strlen(pattern);
+	end = strchr(p, '"');
+	if (end == NULL || end - p >= NAME_LEN)
+		return -1;
+	memcpy(out, p, end - p);
+	out[end - p] = '\0';
+
+	return 0;
+}
+
+/* Find the numeric value of "key" in a line of JSON. */
+static int json_number(const char *line, const char *key, double *out)
+{
+	char pattern[NAME_LEN + 8];
+	const char *p;
+	char *end;
+
+	sprintf(pattern, "\"%s\": ", key);
+	p = strstr(line, pattern);
+	if (p == NULL)
+		return -1;
+	p += strlen(pattern);
+	*out = strtod(p, &end);
+
+	return (end == p) ? -1 : 0;
+}
+
+/*
+ * Read the output of a previous run. Only the fields needed for the
+ * comparison are parsed, and the file is expected to have one result per line
+ * (as written by write_json).
+ */
+static int load_baseline(const char *path)
+{
+	FILE *f = fopen(path, "r");
+	char line[512];
+
+	if (f == NULL) {
+		perror(path);
+		return -1;
+	}
+
+	while (fgets(line, sizeof(line), f) != NULL) {
+		struct baseline_entry e;
+
+		if (json_string(line, "group", e.group)
+		    || json_string(line, "name", e.name)
+		    || json_number(line, "ns", &e.ns))
+			continue;
+
+		if (baseline_len == baseline_cap) {
+			size_t cap = baseline_cap ? 2 * baseline_cap : 256;
+			void *p = realloc(baseline, cap * sizeof(*baseline));
+
+			if (p == NULL) {
+				fclose(f);
+				return -1;
+			}
+			baseline = p;
+			baseline_cap = cap;
+		}
+		baseline[baseline_len++] = e;
+	}
+
+	fclose(f);
+
+	return 0;
+}
+
+static const struct baseline_entry *find_baseline(const char *group,
+						  const char *name)
+{
+	size_t i;
+
+	for (i = 0; i < baseline_len; i++) {
+		if (!strcmp(baseline[i].group, group)
+		    && !strcmp(baseline[i].name, name))
+			return &baseline[i];
+	}
+
+	return NULL;
+}
+
+/* ################################ Output ################################## */
+
+static void json_value(FILE *f, const char *key, double v)
+{
+	if (isfinite(v))
+		fprintf(f, ", \"%s\": %.4f", key, v);
+	else
+		fprintf(f, ", \"%s\": null", key);
+}
+
+static void usage(const char *prog)
+{
+	fprintf(stderr,
+		"usage: %s [-o output.json] [-b baseline.json] [-t tolerance]"
+		" [-f filter] [-i isa]\n"
+		"  -o  write the results to a file\n"
+		"  -b  compare with the results of a previous run\n"
+		"  -t  maximum slowdown with respect to the baseline,"
+		" in percent (default 10)\n"
+		"  -f  only run the benchmarks whose name contains filter\n"
+		"  -i  select the instruction set (see fxp_isa_select)\n",
+		prog);
+}
+
+static int select_isa(const char *name)
+{
+	int isa;
+
+	for (isa = 0; isa < FXP_ISA_COUNT; isa++) {
+		if (!strcmp(name, fxp_isa_name((fxp_isa)isa)))
+			return fxp_isa_select((fxp_isa)isa) ? 0 : -1;
+	}
+
+	return -1;
+}
+
+int main(int argc, char *argv[])
+{
+	const char *out_path = NULL, *baseline_path = NULL, *filter = NULL;
+	double tolerance = 10;
+	FILE *out = NULL;
+	size_t g, n_slower = 0, n_run = 0;
+	int i;
+
+	for (i = 1; i < argc; i++) {
+		const char *arg = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+		if (arg == NULL || argv[i][0] != '-' || strlen(argv[i]) != 2) {
+			usage(argv[0]);
+			return 2;
+		}
+
+		switch (argv[i][1]) {
+		case 'o':
+			out_path = arg;
+			break;
+		case 'b':
+			baseline_path = arg;
+			break;
+		case 't':
+			tolerance = atof(arg);
+			break;
+		case 'f':
+			filter = arg;
+			break;
+		case 'i':
+			if (select_isa(arg)) {
+				fprintf(stderr, "instruction set not available:"
+					" %s\n", arg);
+				return 2;
+			}
+			break;
+		default:
+			usage(argv[0]);
+			return 2;
+		}
+		i++;
+	}
+
+	if (baseline_path != NULL && load_baseline(baseline_path))
+		return 2;
+
+	if (out_path != NULL) {
+		out = fopen(out_path, "w");
+		if (out == NULL) {
+			perror(out_path);
+			return 2;
+		}
+		fprintf(out, "{\n\t\"isa\": \"%s\",\n\t\"len\": %d,\n"
+			"\t\"results\": [",
+			fxp_isa_name(fxp_isa_active()), BENCH_LEN);
+	}
+
+	bench_data_init();
+	bench_batch_init();
+
+	printf("instruction set: %s\n", fxp_isa_name(fxp_isa_active()));
+	printf("%-10s %-20s %8s %8s %8s %8s %8s\n", "group", "name",
+	       "ns/op", "cyc/op", "float ns", "ratio", "vs base");
+
+	for (g = 0; g < N_GROUPS; g++) {
+		const struct bench *b;
+
+		for (b = groups[g].table; b->name != NULL; b++) {
+			const struct baseline_entry *base;
+			struct timing fx, fl = {NAN, NAN};
+
+			if (filter != NULL && strstr(b->name, filter) == NULL)
+				continue;
+
+			fx = measure(b->fixed);
+			if (b->real != NULL)
+				fl = measure(b->real);
+
+			printf("%-10s %-20s %8.3f %8.2f", groups[g].name,
+			       b->name, fx.ns, fx.cycles);
+			if (b->real != NULL)
+				printf(" %8.3f %8.2f", fl.ns, fx.ns / fl.ns);
+			else
+				printf(" %8s %8s", "-", "-");
+
+			base = find_baseline(groups[g].name, b->name);
+			if (base != NULL) {
+				double change = 100 * (fx.ns / base->ns - 1);
+
+				printf(" %+7.1f%%", change);
+				if (change > tolerance) {
+					printf("  SLOWER");
+					n_slower++;
+				}
+			}
+			printf("\n");
+
+			if (out != NULL) {
+				fprintf(out, "%s\n\t\t{\"group\": \"%s\","
+					" \"name\": \"%s\"",
+					n_run ? "," : "", groups[g].name,
+					b->name);
+				json_value(out, "ns", fx.ns);
+				json_value(out, "cycles", fx.cycles);
+				json_value(out, "float_ns", fl.ns);
+				json_value(out, "float_cycles", fl.cycles);
+				fprintf(out, "}");
+			}
+			n_run++;
+		}
+	}
+
+	if (out != NULL) {
+		fprintf(out, "\n\t]\n}\n");
+		fclose(out);
+	}
+
+	if (baseline_path != NULL) {
+		printf("%lu of %lu benchmarks are more than %.1f%% slower than"
+		       " the baseline\n", (unsigned long)n_slower,
+		       (unsigned long)n_run, tolerance);
+	}
+
+	free(baseline);
+
+	return n_slower ? 1 : 0;
+}
@@ -0,0 +1,217 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Micro-benchmark harness.
+ *
+ * Every benchmark processes BENCH_LEN elements from the global buffers declared
+ * below and is timed per element. Most benchmarks come with an equivalent
+ * single precision floating point implementation, which serves as a
+ * reference.
+ */
+
+#ifndef FXP_BENCH_H
+#define FXP_BENCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "fixed_point/fixed_point.h"
+#include "fixed_point/vector.h"
+#include "fixed_point/quaternion.h"
+#include "fixed_point/matrix.h"
+
+/** Number of elements processed by each call of a benchmark. */
+#define BENCH_LEN 1024
+
+/**
+ * Keep the compiler from optimizing away or merging repetitions.
+ *
+ * The results are written to global buffers, but the compiler could still
+ * notice that every repetition stores the same values.
+ */
+#ifdef __GNUC__
+#define BENCH_CLOBBER() __asm__ __volatile__("" ::: "memory")
+#else
+#define BENCH_CLOBBER() ((void)0)
+#endif
+
+/**
+ * Define a benchmark that evaluates an expression for every element.
+ *
+ * @param	name	Name of the function to be defined.
+ * @param	expr	Expression to evaluate for element i.
+ */
+#define BENCH_LOOP(name, expr)						\
+static void name(size_t reps)						\
+{									\
+	size_t r, i;							\
+									\
+	for (r = 0; r < reps; r++) {					\
+		for (i = 0; i < BENCH_LEN; i++)				\
+			expr;						\
+		BENCH_CLOBBER();					\
+	}								\
+}
+
+/**
+ * Define a benchmark that makes a single call to process all the elements.
+ *
+ * @param	name	Name of the function to be defined.
+ * @param	stmt	Statement to execute.
+ */
+#define BENCH_CALL(name, stmt)						\
+static void name(size_t reps)						\
+{									\
+	size_t r;							\
+									\
+	for (r = 0; r < reps; r++) {					\
+		stmt;							\
+		BENCH_CLOBBER();					\
+	}								\
+}
+
+/**
+ * Define a benchmark and its floating point reference.
+ *
+ * This defines bench_##name and real_##name. Use @ref BENCH_ENTRY to add them
+ * to a table.
+ */
+#define BENCH(name, expr, real_expr)					\
+	BENCH_LOOP(bench_##name, expr)					\
+	BENCH_LOOP(real_##name, real_expr)
+
+/** Define a benchmark without a floating point reference. */
+#define BENCH_ONLY(name, expr) BENCH_LOOP(bench_##name, expr)
+
+/**
+ * Define a benchmark of a function that processes a whole array, and its
+ * floating point reference.
+ */
+#define BENCH_N(name, stmt, real_expr)					\
+	BENCH_CALL(bench_##name, stmt)					\
+	BENCH_LOOP(real_##name, real_expr)
+
+/** Define a benchmark of an array function without a reference. */
+#define BENCH_N_ONLY(name, stmt) BENCH_CALL(bench_##name, stmt)
+
+/** Table entry for a benchmark defined with @ref BENCH. */
+#define BENCH_ENTRY(name) {#name, bench_##name, real_##name}
+
+/** Table entry for a benchmark defined with @ref BENCH_ONLY. */
+#define BENCH_ENTRY_ONLY(name) {#name, bench_##name, NULL}
+
+/** Terminates a table of benchmarks. */
+#define BENCH_END {NULL, NULL, NULL}
+
+typedef void (*bench_fn)(size_t reps);
+
+/**
+ * A benchmark.
+ */
+struct bench {
+	const char *name;	/*!< Name of the function being measured */
+	bench_fn fixed;		/*!< Fixed point code, run reps times */
+	bench_fn real;		/*!< Floating point reference, or NULL */
+};
+
+/* Tables of benchmarks, terminated by BENCH_END */
+extern const struct bench bench_scalar[];
+extern const struct bench bench_vector[];
+extern const struct bench bench_quaternion[];
+extern const struct bench bench_matrix[];
+extern const struct bench bench_batch[];
+
+/* ############################# Buffers #################################### */
+
+/** Single precision floating point vector. */
+typedef struct {
+	float x, y, z;
+} fvec3;
+
+/** Single precision floating point quaternion. */
+typedef struct {
+	float r;
+	fvec3 v;
+} fquat;
+
+/** Single precision floating point matrix, stored by rows. */
+typedef struct {
+	fvec3 x, y, z;
+} fmat3;
+
+extern frac f_x[BENCH_LEN], f_y[BENCH_LEN], f_r[BENCH_LEN], f_s[BENCH_LEN];
+extern dfrac d_x[BENCH_LEN], d_y[BENCH_LEN], d_r[BENCH_LEN];
+extern efrac e_x[BENCH_LEN], e_y[BENCH_LEN], e_r[BENCH_LEN];
+extern lfrac l_x[BENCH_LEN], l_y[BENCH_LEN], l_r[BENCH_LEN];
+extern mfrac m_x[BENCH_LEN];
+extern int16_t i_x[BENCH_LEN];		/* Between -100 and 100, not 0 */
+extern int8_t sh_x[BENCH_LEN];		/* Between 0 and 15 */
+extern int i_r[BENCH_LEN];
+extern bool b_r[BENCH_LEN];
+extern idivider div_x;
+
+extern vec3 v_x[BENCH_LEN], v_y[BENCH_LEN], v_r[BENCH_LEN];
+extern dvec3 dv_x[BENCH_LEN], dv_y[BENCH_LEN], dv_r[BENCH_LEN];
+extern evec3 ev_x[BENCH_LEN], ev_y[BENCH_LEN], ev_r[BENCH_LEN];
+extern mvec3 mv_x[BENCH_LEN];
+extern quat q_x[BENCH_LEN], q_y[BENCH_LEN], q_r[BENCH_LEN];
+extern dquat dq_x[BENCH_LEN], dq_y[BENCH_LEN], dq_r[BENCH_LEN];
+/* Rotation matrices of q_x and q_y */
+extern mat3 m3_x[BENCH_LEN], m3_y[BENCH_LEN], m3_r[BENCH_LEN];
+extern dmat3 dm3_x[BENCH_LEN], dm3_r[BENCH_LEN];
+
+/* Same values as f_x, f_y, etc. */
+extern float fl_x[BENCH_LEN], fl_y[BENCH_LEN], fl_r[BENCH_LEN], fl_s[BENCH_LEN];
+extern float fli_x[BENCH_LEN];		/* Same values as i_x */
+extern double db_x[BENCH_LEN], db_r[BENCH_LEN];	/* Same values as d_x */
+extern fvec3 fv_x[BENCH_LEN], fv_y[BENCH_LEN], fv_r[BENCH_LEN];
+extern fquat fq_x[BENCH_LEN], fq_y[BENCH_LEN], fq_r[BENCH_LEN];
+extern fmat3 fm3_x[BENCH_LEN], fm3_y[BENCH_LEN], fm3_r[BENCH_LEN];
+
+/** Clip x between -limit and limit. */
+static inline float clipf(float x, float limit)
+{
+	return (x < -limit) ? -limit : ((x > limit) ? limit : x);
+}
+
+/**
+ * Fill the buffers with pseudo-random data.
+ *
+ * The data is the same on every run.
+ */
+void bench_data_init(void);
+
+/**
+ * Initialize the filters and transforms used by bench_batch.
+ */
+void bench_batch_init(void);
+
+#endif /* FXP_BENCH_H */
@@ -0,0 +1,198 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Input and output buffers for the benchmarks.
+ */
+
+#include "bench.h"
+
+frac f_x[BENCH_LEN], f_y[BENCH_LEN], f_r[BENCH_LEN], f_s[BENCH_LEN];
+dfrac d_x[BENCH_LEN], d_y[BENCH_LEN], d_r[BENCH_LEN];
+efrac e_x[BENCH_LEN], e_y[BENCH_LEN], e_r[BENCH_LEN];
+lfrac l_x[BENCH_LEN], l_y[BENCH_LEN], l_r[BENCH_LEN];
+mfrac m_x[BENCH_LEN];
+int16_t i_x[BENCH_LEN];
+int8_t sh_x[BENCH_LEN];
+int i_r[BENCH_LEN];
+bool b_r[BENCH_LEN];
+idivider div_x;
+
+vec3 v_x[BENCH_LEN], v_y[BENCH_LEN], v_r[BENCH_LEN];
+dvec3 dv_x[BENCH_LEN], dv_y[BENCH_LEN], dv_r[BENCH_LEN];
+evec3 ev_x[BENCH_LEN], ev_y[BENCH_LEN], ev_r[BENCH_LEN];
+mvec3 mv_x[BENCH_LEN];
+quat q_x[BENCH_LEN], q_y[BENCH_LEN], q_r[BENCH_LEN];
+dquat dq_x[BENCH_LEN], dq_y[BENCH_LEN], dq_r[BENCH_LEN];
+mat3 m3_x[BENCH_LEN], m3_y[BENCH_LEN], m3_r[BENCH_LEN];
+dmat3 dm3_x[BENCH_LEN], dm3_r[BENCH_LEN];
+
+float fl_x[BENCH_LEN], fl_y[BENCH_LEN], fl_r[BENCH_LEN], fl_s[BENCH_LEN];
+float fli_x[BENCH_LEN];
+double db_x[BENCH_LEN], db_r[BENCH_LEN];
+fvec3 fv_x[BENCH_LEN], fv_y[BENCH_LEN], fv_r[BENCH_LEN];
+fquat fq_x[BENCH_LEN], fq_y[BENCH_LEN], fq_r[BENCH_LEN];
+fmat3 fm3_x[BENCH_LEN], fm3_y[BENCH_LEN], fm3_r[BENCH_LEN];
+
+static uint32_t seed = 1;
+
+/* Linear congruential generator, the upper bits are good enough */
+static uint32_t rnd(void)
+{
+	seed = seed * 1664525u + 1013904223u;
+	return seed;
+}
+
+static int16_t rnd16(void)
+{
+	return (int16_t)((int32_t)(rnd() >> 16) - 32768);
+}
+
+static int32_t rnd32(void)
+{
+	return (int32_t)((int64_t)rnd() - 2147483648);
+}
+
+static vec3 rnd_vec3(void)
+{
+	vec3 r;
+
+	r.x.v = rnd16();
+	r.y.v = rnd16();
+	r.z.v = rnd16();
+
+	return r;
+}
+
+static dvec3 rnd_dvec3(void)
+{
+	dvec3 r;
+
+	r.x.v = rnd32();
+	r.y.v = rnd32();
+	r.z.v = rnd32();
+
+	return r;
+}
+
+static fvec3 vec3_to_fvec3(vec3 a)
+{
+	fvec3 r;
+
+	r.x = F_TO_FLOAT(a.x);
+	r.y = F_TO_FLOAT(a.y);
+	r.z = F_TO_FLOAT(a.z);
+
+	return r;
+}
+
+static fmat3 mat3_to_fmat3(mat3 a)
+{
+	fmat3 r;
+
+	r.x = vec3_to_fvec3(a.x);
+	r.y = vec3_to_fvec3(a.y);
+	r.z = vec3_to_fvec3(a.z);
+
+	return r;
+}
+
+void bench_data_init(void)
+{
+	size_t i;
+
+	for (i = 0; i < BENCH_LEN; i++) {
+		quat q;
+		dquat dq;
+
+		f_x[i].v = rnd16();
+		f_y[i].v = rnd16();
+		f_s[i].v = rnd16();
+		d_x[i].v = rnd32();
+		d_y[i].v = rnd32();
+		/* between -8 and 8 */
+		e_x[i].v = rnd32() >> 13;
+		e_y[i].v = rnd32() >> 13;
+		l_x[i].v = (int64_t)rnd32() * 256;
+		l_y[i].v = (int64_t)rnd32() * 256;
+		m_x[i].v = rnd16();
+		i_x[i] = (int16_t)(rnd() % 100 + 1);
+		if (rnd() & 0x10000)
+			i_x[i] = -i_x[i];
+		sh_x[i] = (int8_t)(rnd() >> 28);
+
+		v_x[i] = rnd_vec3();
+		v_y[i] = rnd_vec3();
+		dv_x[i] = rnd_dvec3();
+		dv_y[i] = rnd_dvec3();
+		ev_x[i].x.v = rnd32() >> 13;
+		ev_x[i].y.v = rnd32() >> 13;
+		ev_x[i].z.v = rnd32() >> 13;
+		ev_y[i].x.v = rnd32() >> 13;
+		ev_y[i].y.v = rnd32() >> 13;
+		ev_y[i].z.v = rnd32() >> 13;
+		mv_x[i].x.v = rnd16();
+		mv_x[i].y.v = rnd16();
+		mv_x[i].z.v = rnd16();
+
+		/* rotations are the typical use of quaternions */
+		q.r.v = rnd16();
+		q.v = rnd_vec3();
+		q_x[i] = q_normalize(q);
+		q.r.v = rnd16();
+		q.v = rnd_vec3();
+		q_y[i] = q_normalize(q);
+		dq.r.v = rnd32();
+		dq.v = rnd_dvec3();
+		dq_x[i] = dq_normalize(dq);
+		dq.r.v = rnd32();
+		dq.v = rnd_dvec3();
+		dq_y[i] = dq_normalize(dq);
+		m3_x[i] = q_to_mat3(q_x[i]);
+		m3_y[i] = q_to_mat3(q_y[i]);
+		dm3_x[i] = q_to_dmat3(q_x[i]);
+
+		fl_x[i] = F_TO_FLOAT(f_x[i]);
+		fl_y[i] = F_TO_FLOAT(f_y[i]);
+		fl_s[i] = F_TO_FLOAT(f_s[i]);
+		db_x[i] = DF_TO_DOUBLE(d_x[i]);
+		fli_x[i] = i_x[i];
+		fv_x[i] = vec3_to_fvec3(v_x[i]);
+		fv_y[i] = vec3_to_fvec3(v_y[i]);
+		fq_x[i].r = F_TO_FLOAT(q_x[i].r);
+		fq_x[i].v = vec3_to_fvec3(q_x[i].v);
+		fq_y[i].r = F_TO_FLOAT(q_y[i].r);
+		fq_y[i].v = vec3_to_fvec3(q_y[i].v);
+		fm3_x[i] = mat3_to_fmat3(m3_x[i]);
+		fm3_y[i] = mat3_to_fmat3(m3_y[i]);
+	}
+
+	idiv_init(&div_x, 7);
+}
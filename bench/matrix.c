@@ -0,0 +1,134 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Benchmarks of the matrix routines.
+ *
+ * The matrices are rotations, so q_rot from the quaternion group is the cost
+ * to compare with m3_mul_v and dm3_mul_v.
+ */
+
+#include "bench.h"
+
+static fmat3 fm3_transpose(fmat3 m)
+{
+	fmat3 r;
+
+	r.x.x = m.x.x; r.x.y = m.y.x; r.x.z = m.z.x;
+	r.y.x = m.x.y; r.y.y = m.y.y; r.y.z = m.z.y;
+	r.z.x = m.x.z; r.z.y = m.y.z; r.z.z = m.z.z;
+
+	return r;
+}
+
+static float fv_dot(fvec3 a, fvec3 b)
+{
+	return a.x*b.x + a.y*b.y + a.z*b.z;
+}
+
+static fvec3 fm3_mul_v(fmat3 m, fvec3 v)
+{
+	fvec3 r;
+
+	r.x = fv_dot(m.x, v);
+	r.y = fv_dot(m.y, v);
+	r.z = fv_dot(m.z, v);
+
+	return r;
+}
+
+static fmat3 fm3_mul(fmat3 a, fmat3 b)
+{
+	fmat3 bt = fm3_transpose(b), r;
+
+	r.x = fm3_mul_v(bt, a.x);
+	r.y = fm3_mul_v(bt, a.y);
+	r.z = fm3_mul_v(bt, a.z);
+
+	return r;
+}
+
+/* Homogeneous form, like q_to_dmat3 */
+static fmat3 fq_to_fm3(fquat q)
+{
+	float rr = q.r*q.r, xx = q.v.x*q.v.x, yy = q.v.y*q.v.y,
+	      zz = q.v.z*q.v.z, xy = q.v.x*q.v.y, xz = q.v.x*q.v.z,
+	      yz = q.v.y*q.v.z, rx = q.r*q.v.x, ry = q.r*q.v.y,
+	      rz = q.r*q.v.z;
+	fmat3 m;
+
+	m.x.x = rr + xx - yy - zz;
+	m.x.y = 2 * (xy - rz);
+	m.x.z = 2 * (xz + ry);
+	m.y.x = 2 * (xy + rz);
+	m.y.y = rr - xx + yy - zz;
+	m.y.z = 2 * (yz - rx);
+	m.z.x = 2 * (xz - ry);
+	m.z.y = 2 * (yz + rx);
+	m.z.z = rr - xx - yy + zz;
+
+	return m;
+}
+
+BENCH(m3_transpose, m3_r[i] = m3_transpose(m3_x[i]),
+      fm3_r[i] = fm3_transpose(fm3_x[i]))
+BENCH(dm3_transpose, dm3_r[i] = dm3_transpose(dm3_x[i]),
+      fm3_r[i] = fm3_transpose(fm3_x[i]))
+BENCH_ONLY(m3_to_dm3, dm3_r[i] = m3_to_dm3(m3_x[i]))
+BENCH_ONLY(dm3_to_m3, m3_r[i] = dm3_to_m3(dm3_x[i]))
+BENCH(m3_mul_v_dv, dv_r[i] = m3_mul_v_dv(m3_x[i], v_x[i]),
+      fv_r[i] = fm3_mul_v(fm3_x[i], fv_x[i]))
+BENCH(m3_mul_v, v_r[i] = m3_mul_v(m3_x[i], v_x[i]),
+      fv_r[i] = fm3_mul_v(fm3_x[i], fv_x[i]))
+BENCH(dm3_mul_v, v_r[i] = dm3_mul_v(dm3_x[i], v_x[i]),
+      fv_r[i] = fm3_mul_v(fm3_x[i], fv_x[i]))
+BENCH(m3_mul_dm, dm3_r[i] = m3_mul_dm(m3_x[i], m3_y[i]),
+      fm3_r[i] = fm3_mul(fm3_x[i], fm3_y[i]))
+BENCH(m3_mul, m3_r[i] = m3_mul(m3_x[i], m3_y[i]),
+      fm3_r[i] = fm3_mul(fm3_x[i], fm3_y[i]))
+BENCH(q_to_dmat3, dm3_r[i] = q_to_dmat3(q_x[i]),
+      fm3_r[i] = fq_to_fm3(fq_x[i]))
+BENCH(q_to_mat3, m3_r[i] = q_to_mat3(q_x[i]),
+      fm3_r[i] = fq_to_fm3(fq_x[i]))
+
+const struct bench bench_matrix[] = {
+	BENCH_ENTRY(m3_transpose),
+	BENCH_ENTRY(dm3_transpose),
+	BENCH_ENTRY_ONLY(m3_to_dm3),
+	BENCH_ENTRY_ONLY(dm3_to_m3),
+	BENCH_ENTRY(m3_mul_v_dv),
+	BENCH_ENTRY(m3_mul_v),
+	BENCH_ENTRY(dm3_mul_v),
+	BENCH_ENTRY(m3_mul_dm),
+	BENCH_ENTRY(m3_mul),
+	BENCH_ENTRY(q_to_dmat3),
+	BENCH_ENTRY(q_to_mat3),
+	BENCH_END
+};
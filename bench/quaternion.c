@@ -0,0 +1,158 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Benchmarks of the quaternion routines.
+ */
+
+#include <math.h>
+#include "bench.h"
+
+static fquat fq_add(fquat q, fquat p)
+{
+	fquat r;
+
+	r.r = q.r + p.r;
+	r.v.x = q.v.x + p.v.x;
+	r.v.y = q.v.y + p.v.y;
+	r.v.z = q.v.z + p.v.z;
+
+	return r;
+}
+
+static fquat fq_scale(fquat q, float f)
+{
+	fquat r;
+
+	r.r = q.r * f;
+	r.v.x = q.v.x * f;
+	r.v.y = q.v.y * f;
+	r.v.z = q.v.z * f;
+
+	return r;
+}
+
+static fquat fq_conj(fquat q)
+{
+	fquat r;
+
+	r.r = q.r;
+	r.v.x = -q.v.x;
+	r.v.y = -q.v.y;
+	r.v.z = -q.v.z;
+
+	return r;
+}
+
+static fquat fq_mul(fquat q, fquat p)
+{
+	fquat r;
+
+	r.r = q.r*p.r - q.v.x*p.v.x - q.v.y*p.v.y - q.v.z*p.v.z;
+	r.v.x = q.r*p.v.x + q.v.x*p.r + q.v.y*p.v.z - q.v.z*p.v.y;
+	r.v.y = q.r*p.v.y - q.v.x*p.v.z + q.v.y*p.r + q.v.z*p.v.x;
+	r.v.z = q.r*p.v.z + q.v.x*p.v.y - q.v.y*p.v.x + q.v.z*p.r;
+
+	return r;
+}
+
+static float fq_norm2(fquat q)
+{
+	return q.r*q.r + q.v.x*q.v.x + q.v.y*q.v.y + q.v.z*q.v.z;
+}
+
+/* v' = v + 2r(u x v) + 2u x (u x v) */
+static fvec3 fq_rot(fquat q, fvec3 v)
+{
+	fvec3 t, r;
+
+	t.x = 2 * (q.v.y*v.z - q.v.z*v.y);
+	t.y = 2 * (q.v.z*v.x - q.v.x*v.z);
+	t.z = 2 * (q.v.x*v.y - q.v.y*v.x);
+	r.x = v.x + q.r*t.x + q.v.y*t.z - q.v.z*t.y;
+	r.y = v.y + q.r*t.y + q.v.z*t.x - q.v.x*t.z;
+	r.z = v.z + q.r*t.z + q.v.x*t.y - q.v.y*t.x;
+
+	return r;
+}
+
+BENCH_ONLY(dq_to_q, q_r[i] = dq_to_q(dq_x[i]))
+BENCH(q_xnormerror, f_r[i] = q_xnormerror(q_x[i]),
+      fl_r[i] = 1.0f - fq_norm2(fq_x[i]))
+BENCH(q_scale_dq, dq_r[i] = q_scale_dq(q_x[i], f_y[i]),
+      fq_r[i] = fq_scale(fq_x[i], fl_y[i]))
+BENCH(q_scale, q_r[i] = q_scale(q_x[i], f_y[i]),
+      fq_r[i] = fq_scale(fq_x[i], fl_y[i]))
+BENCH(q_conj, q_r[i] = q_conj(q_x[i]), fq_r[i] = fq_conj(fq_x[i]))
+BENCH(q_mul, q_r[i] = q_mul(q_x[i], q_y[i]),
+      fq_r[i] = fq_mul(fq_x[i], fq_y[i]))
+BENCH(q_mul_s_dq, dq_r[i] = q_mul_s_dq(q_x[i], q_y[i], i_x[i]),
+      fq_r[i] = fq_scale(fq_mul(fq_x[i], fq_y[i]), 1.0f / fli_x[i]))
+BENCH(q_mul_dq, dq_r[i] = q_mul_dq(q_x[i], q_y[i]),
+      fq_r[i] = fq_mul(fq_x[i], fq_y[i]))
+BENCH(dq_add, dq_r[i] = dq_add(dq_x[i], dq_y[i]),
+      fq_r[i] = fq_add(fq_x[i], fq_y[i]))
+BENCH(q_add, q_r[i] = q_add(q_x[i], q_y[i]),
+      fq_r[i] = fq_add(fq_x[i], fq_y[i]))
+BENCH(q_rot, v_r[i] = q_rot(q_x[i], v_x[i]),
+      fv_r[i] = fq_rot(fq_x[i], fv_x[i]))
+BENCH(q_xrenorm, q_r[i] = q_xrenorm(q_x[i]),
+      fq_r[i] = fq_scale(fq_x[i], 1.5f - 0.5f * fq_norm2(fq_x[i])))
+BENCH(dq_xrenorm, dq_r[i] = dq_xrenorm(dq_x[i]),
+      fq_r[i] = fq_scale(fq_x[i], 1.5f - 0.5f * fq_norm2(fq_x[i])))
+BENCH(q_normalize, q_r[i] = q_normalize(q_x[i]),
+      fq_r[i] = fq_scale(fq_x[i], 1.0f / sqrtf(fq_norm2(fq_x[i]))))
+BENCH(dq_normalize, dq_r[i] = dq_normalize(dq_x[i]),
+      fq_r[i] = fq_scale(fq_x[i], 1.0f / sqrtf(fq_norm2(fq_x[i]))))
+BENCH_ONLY(q_udecompose, q_r[i] = q_udecompose(q_x[i], AXIS_Z))
+BENCH_ONLY(q_error, v_r[i] = q_error(q_x[i], q_y[i]))
+BENCH_ONLY(q_error2, v_r[i] = q_error2(q_x[i], q_y[i]))
+
+const struct bench bench_quaternion[] = {
+	BENCH_ENTRY_ONLY(dq_to_q),
+	BENCH_ENTRY(q_xnormerror),
+	BENCH_ENTRY(q_scale_dq),
+	BENCH_ENTRY(q_scale),
+	BENCH_ENTRY(q_conj),
+	BENCH_ENTRY(q_mul),
+	BENCH_ENTRY(q_mul_s_dq),
+	BENCH_ENTRY(q_mul_dq),
+	BENCH_ENTRY(dq_add),
+	BENCH_ENTRY(q_add),
+	BENCH_ENTRY(q_rot),
+	BENCH_ENTRY(q_xrenorm),
+	BENCH_ENTRY(dq_xrenorm),
+	BENCH_ENTRY(q_normalize),
+	BENCH_ENTRY(dq_normalize),
+	BENCH_ENTRY_ONLY(q_udecompose),
+	BENCH_ENTRY_ONLY(q_error),
+	BENCH_ENTRY_ONLY(q_error2),
+	BENCH_END
+};
@@ -0,0 +1,246 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Benchmarks of the scalar routines.
+ */
+
+#include <math.h>
+#include "fixed_point/cordic.h"
+#include "fixed_point/divide.h"
+#include "fixed_point/sqrt.h"
+#include "fixed_point/trig.h"
+#include "bench.h"
+
+#define PI_F 3.14159265f
+
+static idivider div_r[BENCH_LEN];
+
+/* ############################## Comparisons ############################### */
+
+BENCH(f_gt, b_r[i] = f_gt(f_x[i], f_y[i]), b_r[i] = fl_x[i] > fl_y[i])
+BENCH(f_ge, b_r[i] = f_ge(f_x[i], f_y[i]), b_r[i] = fl_x[i] >= fl_y[i])
+BENCH(f_lt, b_r[i] = f_lt(f_x[i], f_y[i]), b_r[i] = fl_x[i] < fl_y[i])
+BENCH(f_le, b_r[i] = f_le(f_x[i], f_y[i]), b_r[i] = fl_x[i] <= fl_y[i])
+BENCH(f_eq, b_r[i] = f_eq(f_x[i], f_y[i]), b_r[i] = fl_x[i] == fl_y[i])
+BENCH(df_gt, b_r[i] = df_gt(d_x[i], d_y[i]), b_r[i] = fl_x[i] > fl_y[i])
+BENCH(df_ge, b_r[i] = df_ge(d_x[i], d_y[i]), b_r[i] = fl_x[i] >= fl_y[i])
+BENCH(df_lt, b_r[i] = df_lt(d_x[i], d_y[i]), b_r[i] = fl_x[i] < fl_y[i])
+BENCH(df_le, b_r[i] = df_le(d_x[i], d_y[i]), b_r[i] = fl_x[i] <= fl_y[i])
+BENCH(df_eq, b_r[i] = df_eq(d_x[i], d_y[i]), b_r[i] = fl_x[i] == fl_y[i])
+
+/* ############################### Arithmetic ############################### */
+
+BENCH(f_add, f_r[i] = f_add(f_x[i], f_y[i]), fl_r[i] = fl_x[i] + fl_y[i])
+BENCH(f_sub, f_r[i] = f_sub(f_x[i], f_y[i]), fl_r[i] = fl_x[i] - fl_y[i])
+BENCH(df_add, d_r[i] = df_add(d_x[i], d_y[i]), fl_r[i] = fl_x[i] + fl_y[i])
+BENCH(df_sub, d_r[i] = df_sub(d_x[i], d_y[i]), fl_r[i] = fl_x[i] - fl_y[i])
+BENCH(ef_add, e_r[i] = ef_add(e_x[i], e_y[i]), fl_r[i] = fl_x[i] + fl_y[i])
+BENCH(ef_sub, e_r[i] = ef_sub(e_x[i], e_y[i]), fl_r[i] = fl_x[i] - fl_y[i])
+BENCH(lf_add, l_r[i] = lf_add(l_x[i], l_y[i]), fl_r[i] = fl_x[i] + fl_y[i])
+BENCH(lf_sub, l_r[i] = lf_sub(l_x[i], l_y[i]), fl_r[i] = fl_x[i] - fl_y[i])
+BENCH(ef_f_add, e_r[i] = ef_f_add(e_x[i], f_y[i]), fl_r[i] = fl_x[i] + fl_y[i])
+BENCH(f_neg, f_r[i] = f_neg(f_x[i]), fl_r[i] = -fl_x[i])
+BENCH(df_neg, d_r[i] = df_neg(d_x[i]), fl_r[i] = -fl_x[i])
+BENCH(ef_neg, e_r[i] = ef_neg(e_x[i]), fl_r[i] = -fl_x[i])
+BENCH(f_mul, f_r[i] = f_mul(f_x[i], f_y[i]), fl_r[i] = fl_x[i] * fl_y[i])
+BENCH(f_mul_df, d_r[i] = f_mul_df(f_x[i], f_y[i]),
+      fl_r[i] = fl_x[i] * fl_y[i])
+BENCH(f_mf_mul_ef, e_r[i] = f_mf_mul_ef(f_x[i], m_x[i]),
+      fl_r[i] = fl_x[i] * fl_y[i])
+BENCH(f_imul, f_r[i] = f_imul(f_x[i], i_x[i]), fl_r[i] = fl_x[i] * fli_x[i])
+BENCH(f_imul_i, i_r[i] = f_imul_i(f_x[i], i_x[i]),
+      i_r[i] = (int)(fl_x[i] * fli_x[i]))
+BENCH(f_imul_ef, e_r[i] = f_imul_ef(f_x[i], i_x[i]),
+      fl_r[i] = fl_x[i] * fli_x[i])
+BENCH(df_imul, d_r[i] = df_imul(d_x[i], i_x[i]), fl_r[i] = fl_x[i] * fli_x[i])
+BENCH(ef_imul, e_r[i] = ef_imul(e_x[i], i_x[i]), fl_r[i] = fl_x[i] * fli_x[i])
+BENCH(f_idiv, f_r[i] = f_idiv(f_x[i], i_x[i]), fl_r[i] = fl_x[i] / fli_x[i])
+BENCH(df_idiv, d_r[i] = df_idiv(d_x[i], i_x[i]), fl_r[i] = fl_x[i] / fli_x[i])
+BENCH(ef_idiv, e_r[i] = ef_idiv(e_x[i], i_x[i]), fl_r[i] = fl_x[i] / fli_x[i])
+BENCH(idiv_init, idiv_init(&div_r[i], i_x[i]), fl_r[i] = 1.0f / fli_x[i])
+BENCH(f_idivd, f_r[i] = f_idivd(f_x[i], &div_x), fl_r[i] = fl_x[i] / 7.0f)
+BENCH(df_idivd, d_r[i] = df_idivd(d_x[i], &div_x), fl_r[i] = fl_x[i] / 7.0f)
+BENCH(ef_idivd, e_r[i] = ef_idivd(e_x[i], &div_x), fl_r[i] = fl_x[i] / 7.0f)
+BENCH(df_shiftl, d_r[i] = df_shiftl(d_x[i], sh_x[i]),
+      fl_r[i] = fl_x[i] * (float)(1 << sh_x[i]))
+BENCH(df_shiftr, d_r[i] = df_shiftr(d_x[i], sh_x[i]),
+      fl_r[i] = fl_x[i] / (float)(1 << sh_x[i]))
+BENCH(f_ef_div, e_r[i] = f_ef_div(f_x[i], e_y[i]), fl_r[i] = fl_x[i] / fl_y[i])
+BENCH(f_clip, f_r[i] = f_clip(f_x[i], _frac(FRAC_1_V / 2)),
+      fl_r[i] = clipf(fl_x[i], 0.5f))
+BENCH(df_addsat, d_r[i] = df_addsat(d_x[i], d_y[i]),
+      fl_r[i] = fl_x[i] + fl_y[i])
+BENCH(df_subsat, d_r[i] = df_subsat(d_x[i], d_y[i]),
+      fl_r[i] = fl_x[i] - fl_y[i])
+BENCH(ef_addsat, e_r[i] = ef_addsat(e_x[i], e_y[i]),
+      fl_r[i] = fl_x[i] + fl_y[i])
+BENCH(ef_subsat, e_r[i] = ef_subsat(e_x[i], e_y[i]),
+      fl_r[i] = fl_x[i] - fl_y[i])
+BENCH(f_addsat, f_r[i] = f_addsat(f_x[i], f_y[i]), fl_r[i] = fl_x[i] + fl_y[i])
+BENCH(f_subsat, f_r[i] = f_subsat(f_x[i], f_y[i]), fl_r[i] = fl_x[i] - fl_y[i])
+BENCH(f_negsat, f_r[i] = f_negsat(f_x[i]), fl_r[i] = -fl_x[i])
+BENCH(f_mulsat, f_r[i] = f_mulsat(f_x[i], f_y[i]), fl_r[i] = fl_x[i] * fl_y[i])
+BENCH(f_mul_r, f_r[i] = f_mul_r(f_x[i], f_y[i]), fl_r[i] = fl_x[i] * fl_y[i])
+BENCH(f_mul_cr, f_r[i] = f_mul_cr(f_x[i], f_y[i]), fl_r[i] = fl_x[i] * fl_y[i])
+BENCH(f_macs_df, d_r[i] = f_macs_df(f_x[i], f_y[i], d_x[i]),
+      fl_r[i] = fl_x[i] * fl_y[i] + fl_s[i])
+BENCH(f_mac_lf, l_r[i] = f_mac_lf(f_x[i], f_y[i], l_x[i]),
+      fl_r[i] = fl_x[i] * fl_y[i] + fl_s[i])
+
+/* ############################## Conversions ############################### */
+
+BENCH_ONLY(df_to_f, f_r[i] = df_to_f(d_x[i]))
+BENCH_ONLY(df_to_f_r, f_r[i] = df_to_f_r(d_x[i]))
+BENCH_ONLY(df_to_f_cr, f_r[i] = df_to_f_cr(d_x[i]))
+BENCH_ONLY(f_to_df, d_r[i] = f_to_df(f_x[i]))
+BENCH_ONLY(f_to_lf, l_r[i] = f_to_lf(f_x[i]))
+BENCH_ONLY(df_to_lf, l_r[i] = df_to_lf(d_x[i]))
+BENCH_ONLY(lf_to_df, d_r[i] = lf_to_df(l_x[i]))
+BENCH_ONLY(lf_to_f, f_r[i] = lf_to_f(l_x[i]))
+BENCH_ONLY(lf_to_f_r, f_r[i] = lf_to_f_r(l_x[i]))
+BENCH_ONLY(f_to_ef, e_r[i] = f_to_ef(f_x[i]))
+BENCH_ONLY(ef_to_f, f_r[i] = ef_to_f(e_x[i]))
+
+/* ######################### Out of line functions ########################## */
+
+BENCH(f_div, f_r[i] = f_div(f_x[i], f_y[i]), fl_r[i] = fl_x[i] / fl_y[i])
+BENCH(df_div, d_r[i] = df_div(d_x[i], d_y[i]), fl_r[i] = fl_x[i] / fl_y[i])
+BENCH(ef_div, e_r[i] = ef_div(e_x[i], e_y[i]), fl_r[i] = fl_x[i] / fl_y[i])
+BENCH(f_recip, e_r[i] = f_recip(f_x[i]), fl_r[i] = 1.0f / fl_x[i])
+BENCH(f_sqrt, f_r[i] = f_sqrt(f_x[i]), fl_r[i] = sqrtf(fl_x[i]))
+BENCH(df_sqrt, d_r[i] = df_sqrt(d_x[i]), fl_r[i] = sqrtf(fl_x[i]))
+BENCH(ef_sqrt, e_r[i] = ef_sqrt(e_x[i]), fl_r[i] = sqrtf(fl_x[i]))
+BENCH(df_rsqrt, d_r[i] = df_rsqrt(d_x[i]), fl_r[i] = 1.0f / sqrtf(fl_x[i]))
+BENCH(f_sin, f_r[i] = f_sin(f_x[i]), fl_r[i] = sinf(fl_x[i] * PI_F))
+BENCH(f_cos, f_r[i] = f_cos(f_x[i]), fl_r[i] = cosf(fl_x[i] * PI_F))
+BENCH(f_sincos, f_sincos(f_x[i], &f_r[i], &f_s[i]),
+      (fl_r[i] = sinf(fl_x[i] * PI_F), fl_s[i] = cosf(fl_x[i] * PI_F)))
+BENCH(f_atan2, f_r[i] = f_atan2(f_x[i], f_y[i]),
+      fl_r[i] = atan2f(fl_x[i], fl_y[i]))
+BENCH(f_hypot, f_r[i] = f_hypot(f_x[i], f_y[i]),
+      fl_r[i] = hypotf(fl_x[i], fl_y[i]))
+BENCH(f_to_polar, f_to_polar(f_x[i], f_y[i], &f_r[i], &f_s[i]),
+      (fl_r[i] = hypotf(fl_x[i], fl_y[i]),
+       fl_s[i] = atan2f(fl_y[i], fl_x[i])))
+BENCH(f_from_polar, f_from_polar(f_x[i], f_y[i], &f_r[i], &f_s[i]),
+      (fl_r[i] = fl_x[i] * cosf(fl_y[i] * PI_F),
+       fl_s[i] = fl_x[i] * sinf(fl_y[i] * PI_F)))
+BENCH_ONLY(f_rotate, f_rotate(&f_r[i], &f_s[i], f_x[i]))
+BENCH(df_atan2, d_r[i] = df_atan2(d_x[i], d_y[i]),
+      fl_r[i] = atan2f(fl_x[i], fl_y[i]))
+BENCH(df_hypot, d_r[i] = df_hypot(d_x[i], d_y[i]),
+      fl_r[i] = hypotf(fl_x[i], fl_y[i]))
+
+const struct bench bench_scalar[] = {
+	BENCH_ENTRY(f_gt),
+	BENCH_ENTRY(f_ge),
+	BENCH_ENTRY(f_lt),
+	BENCH_ENTRY(f_le),
+	BENCH_ENTRY(f_eq),
+	BENCH_ENTRY(df_gt),
+	BENCH_ENTRY(df_ge),
+	BENCH_ENTRY(df_lt),
+	BENCH_ENTRY(df_le),
+	BENCH_ENTRY(df_eq),
+	BENCH_ENTRY(f_add),
+	BENCH_ENTRY(f_sub),
+	BENCH_ENTRY(df_add),
+	BENCH_ENTRY(df_sub),
+	BENCH_ENTRY(ef_add),
+	BENCH_ENTRY(ef_sub),
+	BENCH_ENTRY(lf_add),
+	BENCH_ENTRY(lf_sub),
+	BENCH_ENTRY(ef_f_add),
+	BENCH_ENTRY(f_neg),
+	BENCH_ENTRY(df_neg),
+	BENCH_ENTRY(ef_neg),
+	BENCH_ENTRY(f_mul),
+	BENCH_ENTRY(f_mul_df),
+	BENCH_ENTRY(f_mf_mul_ef),
+	BENCH_ENTRY(f_imul),
+	BENCH_ENTRY(f_imul_i),
+	BENCH_ENTRY(f_imul_ef),
+	BENCH_ENTRY(df_imul),
+	BENCH_ENTRY(ef_imul),
+	BENCH_ENTRY(f_idiv),
+	BENCH_ENTRY(df_idiv),
+	BENCH_ENTRY(ef_idiv),
+	BENCH_ENTRY(idiv_init),
+	BENCH_ENTRY(f_idivd),
+	BENCH_ENTRY(df_idivd),
+	BENCH_ENTRY(ef_idivd),
+	BENCH_ENTRY(df_shiftl),
+	BENCH_ENTRY(df_shiftr),
+	BENCH_ENTRY(f_ef_div),
+	BENCH_ENTRY(f_clip),
+	BENCH_ENTRY(df_addsat),
+	BENCH_ENTRY(df_subsat),
+	BENCH_ENTRY(ef_addsat),
+	BENCH_ENTRY(ef_subsat),
+	BENCH_ENTRY(f_addsat),
+	BENCH_ENTRY(f_subsat),
+	BENCH_ENTRY(f_negsat),
+	BENCH_ENTRY(f_mulsat),
+	BENCH_ENTRY(f_mul_r),
+	BENCH_ENTRY(f_mul_cr),
+	BENCH_ENTRY(f_macs_df),
+	BENCH_ENTRY(f_mac_lf),
+	BENCH_ENTRY_ONLY(df_to_f),
+	BENCH_ENTRY_ONLY(df_to_f_r),
+	BENCH_ENTRY_ONLY(df_to_f_cr),
+	BENCH_ENTRY_ONLY(f_to_df),
+	BENCH_ENTRY_ONLY(f_to_lf),
+	BENCH_ENTRY_ONLY(df_to_lf),
+	BENCH_ENTRY_ONLY(lf_to_df),
+	BENCH_ENTRY_ONLY(lf_to_f),
+	BENCH_ENTRY_ONLY(lf_to_f_r),
+	BENCH_ENTRY_ONLY(f_to_ef),
+	BENCH_ENTRY_ONLY(ef_to_f),
+	BENCH_ENTRY(f_div),
+	BENCH_ENTRY(df_div),
+	BENCH_ENTRY(ef_div),
+	BENCH_ENTRY(f_recip),
+	BENCH_ENTRY(f_sqrt),
+	BENCH_ENTRY(df_sqrt),
+	BENCH_ENTRY(ef_sqrt),
+	BENCH_ENTRY(df_rsqrt),
+	BENCH_ENTRY(f_sin),
+	BENCH_ENTRY(f_cos),
+	BENCH_ENTRY(f_sincos),
+	BENCH_ENTRY(f_atan2),
+	BENCH_ENTRY(f_hypot),
+	BENCH_ENTRY(f_to_polar),
+	BENCH_ENTRY(f_from_polar),
+	BENCH_ENTRY_ONLY(f_rotate),
+	BENCH_ENTRY(df_atan2),
+	BENCH_ENTRY(df_hypot),
+	BENCH_END
+};
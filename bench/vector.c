@@ -0,0 +1,213 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Benchmarks of the vector routines.
+ */
+
+#include <math.h>
+#include "fixed_point/sqrt.h"
+#include "bench.h"
+
+static fvec3 fv_add(fvec3 a, fvec3 b)
+{
+	fvec3 r;
+
+	r.x = a.x + b.x;
+	r.y = a.y + b.y;
+	r.z = a.z + b.z;
+
+	return r;
+}
+
+static fvec3 fv_sub(fvec3 a, fvec3 b)
+{
+	fvec3 r;
+
+	r.x = a.x - b.x;
+	r.y = a.y - b.y;
+	r.z = a.z - b.z;
+
+	return r;
+}
+
+static fvec3 fv_mul(fvec3 a, fvec3 b)
+{
+	fvec3 r;
+
+	r.x = a.x * b.x;
+	r.y = a.y * b.y;
+	r.z = a.z * b.z;
+
+	return r;
+}
+
+static fvec3 fv_scale(fvec3 a, float s)
+{
+	fvec3 r;
+
+	r.x = a.x * s;
+	r.y = a.y * s;
+	r.z = a.z * s;
+
+	return r;
+}
+
+static fvec3 fv_clip(fvec3 a, float limit)
+{
+	fvec3 r;
+
+	r.x = clipf(a.x, limit);
+	r.y = clipf(a.y, limit);
+	r.z = clipf(a.z, limit);
+
+	return r;
+}
+
+static float fv_dot(fvec3 a, fvec3 b)
+{
+	return a.x*b.x + a.y*b.y + a.z*b.z;
+}
+
+static fvec3 fv_cross(fvec3 a, fvec3 b)
+{
+	fvec3 r;
+
+	r.x = a.y*b.z - a.z*b.y;
+	r.y = a.z*b.x - a.x*b.z;
+	r.z = a.x*b.y - a.y*b.x;
+
+	return r;
+}
+
+BENCH(v_add, v_r[i] = v_add(v_x[i], v_y[i]), fv_r[i] = fv_add(fv_x[i], fv_y[i]))
+BENCH(v_sub, v_r[i] = v_sub(v_x[i], v_y[i]), fv_r[i] = fv_sub(fv_x[i], fv_y[i]))
+BENCH(ev_add, ev_r[i] = ev_add(ev_x[i], ev_y[i]),
+      fv_r[i] = fv_add(fv_x[i], fv_y[i]))
+BENCH(ev_sub, ev_r[i] = ev_sub(ev_x[i], ev_y[i]),
+      fv_r[i] = fv_sub(fv_x[i], fv_y[i]))
+BENCH(dv_add, dv_r[i] = dv_add(dv_x[i], dv_y[i]),
+      fv_r[i] = fv_add(fv_x[i], fv_y[i]))
+BENCH(dv_addsat, dv_r[i] = dv_addsat(dv_x[i], dv_y[i]),
+      fv_r[i] = fv_add(fv_x[i], fv_y[i]))
+BENCH(dv_sub, dv_r[i] = dv_sub(dv_x[i], dv_y[i]),
+      fv_r[i] = fv_sub(fv_x[i], fv_y[i]))
+BENCH(v_mvmul_ev, ev_r[i] = v_mvmul_ev(v_x[i], mv_x[i]),
+      fv_r[i] = fv_mul(fv_x[i], fv_y[i]))
+BENCH(v_imul, v_r[i] = v_imul(v_x[i], i_x[i]),
+      fv_r[i] = fv_scale(fv_x[i], fli_x[i]))
+BENCH(dv_imul, dv_r[i] = dv_imul(dv_x[i], i_x[i]),
+      fv_r[i] = fv_scale(fv_x[i], fli_x[i]))
+BENCH(ev_imul, ev_r[i] = ev_imul(ev_x[i], i_x[i]),
+      fv_r[i] = fv_scale(fv_x[i], fli_x[i]))
+BENCH(v_idiv, v_r[i] = v_idiv(v_x[i], i_x[i]),
+      fv_r[i] = fv_scale(fv_x[i], 1.0f / fli_x[i]))
+BENCH(dv_idiv, dv_r[i] = dv_idiv(dv_x[i], i_x[i]),
+      fv_r[i] = fv_scale(fv_x[i], 1.0f / fli_x[i]))
+BENCH(ev_idiv, ev_r[i] = ev_idiv(ev_x[i], i_x[i]),
+      fv_r[i] = fv_scale(fv_x[i], 1.0f / fli_x[i]))
+BENCH(v_idivd, v_r[i] = v_idivd(v_x[i], &div_x),
+      fv_r[i] = fv_scale(fv_x[i], 1.0f / 7))
+BENCH(dv_idivd, dv_r[i] = dv_idivd(dv_x[i], &div_x),
+      fv_r[i] = fv_scale(fv_x[i], 1.0f / 7))
+BENCH(ev_idivd, ev_r[i] = ev_idivd(ev_x[i], &div_x),
+      fv_r[i] = fv_scale(fv_x[i], 1.0f / 7))
+BENCH(dv_shiftl, dv_r[i] = dv_shiftl(dv_x[i], sh_x[i]),
+      fv_r[i] = fv_scale(fv_x[i], (float)(1 << sh_x[i])))
+BENCH(dv_shiftr, dv_r[i] = dv_shiftr(dv_x[i], sh_x[i]),
+      fv_r[i] = fv_scale(fv_x[i], 1.0f / (1 << sh_x[i])))
+BENCH(v_clip, v_r[i] = v_clip(v_x[i], _frac(FRAC_1_V / 2)),
+      fv_r[i] = fv_clip(fv_x[i], 0.5f))
+BENCH(v_imul_ev, ev_r[i] = v_imul_ev(v_x[i], i_x[i]),
+      fv_r[i] = fv_scale(fv_x[i], fli_x[i]))
+BENCH(v_efdiv_ev, ev_r[i] = v_efdiv_ev(v_x[i], e_y[i]),
+      fv_r[i] = fv_scale(fv_x[i], 1.0f / fl_y[i]))
+BENCH(v_fmul, v_r[i] = v_fmul(v_x[i], f_y[i]),
+      fv_r[i] = fv_scale(fv_x[i], fl_y[i]))
+BENCH(v_fmul_dv, dv_r[i] = v_fmul_dv(v_x[i], f_y[i]),
+      fv_r[i] = fv_scale(fv_x[i], fl_y[i]))
+BENCH(v_mfmul_ev, ev_r[i] = v_mfmul_ev(v_x[i], m_x[i]),
+      fv_r[i] = fv_scale(fv_x[i], fl_y[i]))
+BENCH(v_dot_df, d_r[i] = v_dot_df(v_x[i], v_y[i]),
+      fl_r[i] = fv_dot(fv_x[i], fv_y[i]))
+BENCH(v_norm2_df, d_r[i] = v_norm2_df(v_x[i]),
+      fl_r[i] = fv_dot(fv_x[i], fv_x[i]))
+BENCH(v_norm, f_r[i] = v_norm(v_x[i]),
+      fl_r[i] = sqrtf(fv_dot(fv_x[i], fv_x[i])))
+BENCH(v_cross_dv, dv_r[i] = v_cross_dv(v_x[i], v_y[i]),
+      fv_r[i] = fv_cross(fv_x[i], fv_y[i]))
+BENCH(v_cross, v_r[i] = v_cross(v_x[i], v_y[i]),
+      fv_r[i] = fv_cross(fv_x[i], fv_y[i]))
+BENCH_ONLY(ev_to_v, v_r[i] = ev_to_v(ev_x[i]))
+BENCH_ONLY(v_to_ev, ev_r[i] = v_to_ev(v_x[i]))
+BENCH_ONLY(v_to_dv, dv_r[i] = v_to_dv(v_x[i]))
+BENCH_ONLY(dv_to_v, v_r[i] = dv_to_v(dv_x[i]))
+BENCH_ONLY(dv_to_v_r, v_r[i] = dv_to_v_r(dv_x[i]))
+BENCH_ONLY(dv_to_v_cr, v_r[i] = dv_to_v_cr(dv_x[i]))
+
+const struct bench bench_vector[] = {
+	BENCH_ENTRY(v_add),
+	BENCH_ENTRY(v_sub),
+	BENCH_ENTRY(ev_add),
+	BENCH_ENTRY(ev_sub),
+	BENCH_ENTRY(dv_add),
+	BENCH_ENTRY(dv_addsat),
+	BENCH_ENTRY(dv_sub),
+	BENCH_ENTRY(v_mvmul_ev),
+	BENCH_ENTRY(v_imul),
+	BENCH_ENTRY(dv_imul),
+	BENCH_ENTRY(ev_imul),
+	BENCH_ENTRY(v_idiv),
+	BENCH_ENTRY(dv_idiv),
+	BENCH_ENTRY(ev_idiv),
+	BENCH_ENTRY(v_idivd),
+	BENCH_ENTRY(dv_idivd),
+	BENCH_ENTRY(ev_idivd),
+	BENCH_ENTRY(dv_shiftl),
+	BENCH_ENTRY(dv_shiftr),
+	BENCH_ENTRY(v_clip),
+	BENCH_ENTRY(v_imul_ev),
+	BENCH_ENTRY(v_efdiv_ev),
+	BENCH_ENTRY(v_fmul),
+	BENCH_ENTRY(v_fmul_dv),
+	BENCH_ENTRY(v_mfmul_ev),
+	BENCH_ENTRY(v_dot_df),
+	BENCH_ENTRY(v_norm2_df),
+	BENCH_ENTRY(v_norm),
+	BENCH_ENTRY(v_cross_dv),
+	BENCH_ENTRY(v_cross),
+	BENCH_ENTRY_ONLY(ev_to_v),
+	BENCH_ENTRY_ONLY(v_to_ev),
+	BENCH_ENTRY_ONLY(v_to_dv),
+	BENCH_ENTRY_ONLY(dv_to_v),
+	BENCH_ENTRY_ONLY(dv_to_v_r),
+	BENCH_ENTRY_ONLY(dv_to_v_cr),
+	BENCH_END
+};
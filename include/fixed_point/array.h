@@ -0,0 +1,348 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Array versions of the fixed point routines.
+ *
+ * Each function applies the scalar routine of the same name (without the _n
+ * suffix) to every element of one or more arrays. The results are bit-exact
+ * with the scalar routines, even in the cases where those overflow.
+ *
+ * The output array may be the same as one of the inputs, but arrays must not
+ * overlap partially.
+ *
+ * On x86 the library uses SSE2 or AVX2 kernels, depending on the instruction
+ * set enabled at compile time (eg. -mavx2). Define FXP_NO_SIMD when building
+ * the library to use only the portable scalar code.
+ */
+
+#ifndef FXP_ARRAY_H
+#define FXP_ARRAY_H
+
+#include <stddef.h>
+#include "types.h"
+#include "vector_types.h"
+#include "fixed_point.h"
+
+/**
+ * @defgroup fxp_array	Array operations
+ * @{
+ */
+
+/** Array version of @ref f_add - may overflow. */
+void f_add_n(frac *dst, const frac *a, const frac *b, size_t n);
+
+/** Array version of @ref f_sub - may overflow. */
+void f_sub_n(frac *dst, const frac *a, const frac *b, size_t n);
+
+/** Array version of @ref df_add - may overflow. */
+void df_add_n(dfrac *dst, const dfrac *a, const dfrac *b, size_t n);
+
+/** Array version of @ref df_sub - may overflow. */
+void df_sub_n(dfrac *dst, const dfrac *a, const dfrac *b, size_t n);
+
+/** Array version of @ref ef_add - may overflow. */
+void ef_add_n(efrac *dst, const efrac *a, const efrac *b, size_t n);
+
+/** Array version of @ref ef_sub - may overflow. */
+void ef_sub_n(efrac *dst, const efrac *a, const efrac *b, size_t n);
+
+/** Array version of @ref ef_f_add. */
+void ef_f_add_n(efrac *dst, const efrac *a, const frac *b, size_t n);
+
+/** Array version of @ref f_neg. */
+void f_neg_n(frac *dst, const frac *a, size_t n);
+
+/** Array version of @ref df_neg. */
+void df_neg_n(dfrac *dst, const dfrac *a, size_t n);
+
+/** Array version of @ref ef_neg. */
+void ef_neg_n(efrac *dst, const efrac *a, size_t n);
+
+/** Array version of @ref f_mul. */
+void f_mul_n(frac *dst, const frac *a, const frac *b, size_t n);
+
+/** Array version of @ref f_mul_r. */
+void f_mul_r_n(frac *dst, const frac *a, const frac *b, size_t n);
+
+/** Array version of @ref f_mul_cr. */
+void f_mul_cr_n(frac *dst, const frac *a, const frac *b, size_t n);
+
+/** Array version of @ref f_mul_df. */
+void f_mul_df_n(dfrac *dst, const frac *a, const frac *b, size_t n);
+
+/** Array version of @ref f_mf_mul_ef. */
+void f_mf_mul_ef_n(efrac *dst, const frac *a, const mfrac *b, size_t n);
+
+/** Multiply every element by the same integer. See @ref f_imul. */
+void f_imul_n(frac *dst, const frac *a, int16_t b, size_t n);
+
+/** Multiply every element by the same integer. See @ref f_imul_i. */
+void f_imul_i_n(int *dst, const frac *a, int b, size_t n);
+
+/** Multiply every element by the same integer. See @ref f_imul_ef. */
+void f_imul_ef_n(efrac *dst, const frac *a, int16_t b, size_t n);
+
+/** Multiply every element by the same integer. See @ref df_imul. */
+void df_imul_n(dfrac *dst, const dfrac *a, int16_t b, size_t n);
+
+/** Multiply every element by the same integer. See @ref ef_imul. */
+void ef_imul_n(efrac *dst, const efrac *a, int16_t b, size_t n);
+
+/** Divide every element by the same integer. See @ref f_idiv. */
+void f_idiv_n(frac *dst, const frac *a, int16_t b, size_t n);
+
+/** Divide every element by the same integer. See @ref df_idiv. */
+void df_idiv_n(dfrac *dst, const dfrac *a, int16_t b, size_t n);
+
+/** Divide every element by the same integer. See @ref ef_idiv. */
+void ef_idiv_n(efrac *dst, const efrac *a, int16_t b, size_t n);
+
+/** Divide every element by a precomputed divider. See @ref f_idivd. */
+void f_idivd_n(frac *dst, const frac *a, const idivider *d, size_t n);
+
+/** Divide every element by a precomputed divider. See @ref df_idivd. */
+void df_idivd_n(dfrac *dst, const dfrac *a, const idivider *d, size_t n);
+
+/** Divide every element by a precomputed divider. See @ref ef_idivd. */
+void ef_idivd_n(efrac *dst, const efrac *a, const idivider *d, size_t n);
+
+/** Divide every vector by a precomputed divider. See @ref v_idivd. */
+void v_idivd_n(vec3 *dst, const vec3 *a, const idivider *d, size_t n);
+
+/** Divide every vector by a precomputed divider. See @ref dv_idivd. */
+void dv_idivd_n(dvec3 *dst, const dvec3 *a, const idivider *d, size_t n);
+
+/** Divide every vector by a precomputed divider. See @ref ev_idivd. */
+void ev_idivd_n(evec3 *dst, const evec3 *a, const idivider *d, size_t n);
+
+/** Shift every element left by the same amount. See @ref df_shiftl. */
+void df_shiftl_n(dfrac *dst, const dfrac *a, int16_t b, size_t n);
+
+/** Shift every element right by the same amount. See @ref df_shiftr. */
+void df_shiftr_n(dfrac *dst, const dfrac *a, int16_t b, size_t n);
+
+/** Array version of @ref df_to_f. */
+void df_to_f_n(frac *dst, const dfrac *x, size_t n);
+
+/** Array version of @ref df_to_f_r. */
+void df_to_f_r_n(frac *dst, const dfrac *x, size_t n);
+
+/** Array version of @ref df_to_f_cr. */
+void df_to_f_cr_n(frac *dst, const dfrac *x, size_t n);
+
+/** Array version of @ref f_to_df. */
+void f_to_df_n(dfrac *dst, const frac *x, size_t n);
+
+/** Array version of @ref f_to_ef. */
+void f_to_ef_n(efrac *dst, const frac *x, size_t n);
+
+/** Array version of @ref ef_to_f. */
+void ef_to_f_n(frac *dst, const efrac *x, size_t n);
+
+/** Array version of @ref f_ef_div. */
+void f_ef_div_n(efrac *dst, const frac *dividend, const efrac *divisor,
+		size_t n);
+
+/** Clip every element to the same limit. See @ref f_clip. */
+void f_clip_n(frac *dst, const frac *x, frac limit, size_t n);
+
+/** Array version of @ref df_addsat. */
+void df_addsat_n(dfrac *dst, const dfrac *a, const dfrac *b, size_t n);
+
+/** Array version of @ref df_subsat. */
+void df_subsat_n(dfrac *dst, const dfrac *a, const dfrac *b, size_t n);
+
+/** Array version of @ref ef_addsat. */
+void ef_addsat_n(efrac *dst, const efrac *a, const efrac *b, size_t n);
+
+/** Array version of @ref ef_subsat. */
+void ef_subsat_n(efrac *dst, const efrac *a, const efrac *b, size_t n);
+
+/** Array version of @ref f_addsat. */
+void f_addsat_n(frac *dst, const frac *a, const frac *b, size_t n);
+
+/** Array version of @ref f_subsat. */
+void f_subsat_n(frac *dst, const frac *a, const frac *b, size_t n);
+
+/** Array version of @ref f_negsat. */
+void f_negsat_n(frac *dst, const frac *a, size_t n);
+
+/** Array version of @ref f_mulsat. */
+void f_mulsat_n(frac *dst, const frac *a, const frac *b, size_t n);
+
+/**
+ * Element-wise multiply-accumulate with saturation.
+ *
+ * Performs acc[i] = @ref f_macs_df (x[i], y[i], acc[i]) for every element.
+ */
+void f_macs_df_n(dfrac *acc, const frac *x, const frac *y, size_t n);
+
+/** Array version of @ref v_dot_df. */
+void v_dot_df_n(dfrac *dst, const vec3 *a, const vec3 *b, size_t n);
+
+/** Array version of @ref v_norm2_df. */
+void v_norm2_df_n(dfrac *dst, const vec3 *a, size_t n);
+
+/** Array version of @ref v_cross. */
+void v_cross_n(vec3 *dst, const vec3 *a, const vec3 *b, size_t n);
+
+/** Array version of @ref v_cross_dv. */
+void v_cross_dv_n(dvec3 *dst, const vec3 *a, const vec3 *b, size_t n);
+
+/**
+ * @defgroup fxp_array_red	Reductions
+ * @{
+ *
+ * These functions combine all the elements of one or more arrays into a single
+ * value. Intermediate results are kept in a wider accumulator and the result
+ * is saturated only once at the end, so they cannot overflow in the middle of
+ * the computation (as long as n < 2**32).
+ *
+ * Note that the result may differ from that obtained by chaining saturating
+ * scalar operations: a sum that temporarily exceeds the range and then goes
+ * back into range is not clipped.
+ */
+
+/**
+ * Dot product of two single precision arrays, yield double precision.
+ *
+ * @param	x, y	Arrays of length n.
+ * @param	n	Number of elements.
+ *
+ * @return		saturate(sum(x[i]*y[i]))
+ */
+dfrac f_dot_df(const frac *x, const frac *y, size_t n);
+
+/**
+ * Multiply-accumulate an array with a single saturation.
+ *
+ * This is the array counterpart of @ref f_macs_df.
+ *
+ * @param	z	Initial value of the accumulator.
+ * @param	x, y	Arrays of length n.
+ * @param	n	Number of elements.
+ *
+ * @return		saturate(z + sum(x[i]*y[i]))
+ */
+dfrac f_dot_macs_df(dfrac z, const frac *x, const frac *y, size_t n);
+
+/**
+ * Dot product of two single precision arrays, yield a long fractional.
+ *
+ * The result is exact and needs no saturation (see @ref lfrac).
+ *
+ * @param	x, y	Arrays of length n.
+ * @param	n	Number of elements.
+ *
+ * @return		sum(x[i]*y[i])
+ */
+lfrac f_dot_lf(const frac *x, const frac *y, size_t n);
+
+/**
+ * Multiply-accumulate an array into a long fractional.
+ *
+ * This is the array counterpart of @ref f_mac_lf.
+ *
+ * @param	z	Initial value of the accumulator.
+ * @param	x, y	Arrays of length n.
+ * @param	n	Number of elements.
+ *
+ * @return		z + sum(x[i]*y[i])
+ */
+lfrac f_dot_mac_lf(lfrac z, const frac *x, const frac *y, size_t n);
+
+/**
+ * Sum of a double precision array, yield a long fractional.
+ *
+ * @param	x	Array of length n.
+ * @param	n	Number of elements.
+ *
+ * @return		sum(x[i])
+ */
+lfrac df_sum_lf(const dfrac *x, size_t n);
+
+/** @}
+ */
+
+/**
+ * @defgroup fxp_array_real	Conversion to and from floating point
+ * @{
+ *
+ * Unlike the macros in @ref fxp_conv, conversions to fixed point round to
+ * nearest (ties to even) and saturate. NaN is converted to zero.
+ *
+ * The vector kernels use the current floating point rounding mode, so the
+ * results are only guaranteed to match the scalar code in the default mode.
+ */
+
+/** Convert an array of float to frac. */
+void float_to_f_n(frac *dst, const float *x, size_t n);
+
+/** Convert an array of float to dfrac. */
+void float_to_df_n(dfrac *dst, const float *x, size_t n);
+
+/** Convert an array of float to efrac. */
+void float_to_ef_n(efrac *dst, const float *x, size_t n);
+
+/** Convert an array of double to frac. */
+void double_to_f_n(frac *dst, const double *x, size_t n);
+
+/** Convert an array of double to dfrac. */
+void double_to_df_n(dfrac *dst, const double *x, size_t n);
+
+/** Convert an array of double to efrac. */
+void double_to_ef_n(efrac *dst, const double *x, size_t n);
+
+/** Convert an array of frac to float. Exact. */
+void f_to_float_n(float *dst, const frac *x, size_t n);
+
+/** Convert an array of dfrac to float, rounding to 24 significant bits. */
+void df_to_float_n(float *dst, const dfrac *x, size_t n);
+
+/** Convert an array of efrac to float, rounding to 24 significant bits. */
+void ef_to_float_n(float *dst, const efrac *x, size_t n);
+
+/** Convert an array of frac to double. Exact. */
+void f_to_double_n(double *dst, const frac *x, size_t n);
+
+/** Convert an array of dfrac to double. Exact. */
+void df_to_double_n(double *dst, const dfrac *x, size_t n);
+
+/** Convert an array of efrac to double. Exact. */
+void ef_to_double_n(double *dst, const efrac *x, size_t n);
+
+/** @}
+ */
+
+/** @}
+ */
+
+#endif /* FXP_ARRAY_H */
@@ -0,0 +1,173 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * CORDIC routines: arc tangent, magnitude and rotation of 2D vectors.
+ */
+
+#ifndef FXP_CORDIC_H
+#define FXP_CORDIC_H
+
+#include <stddef.h>
+#include "types.h"
+
+/**
+ * @defgroup fxp_cordic	CORDIC
+ * @{
+ *
+ * Conversions between rectangular and polar coordinates, and rotations.
+ *
+ * Angles are binary angles, as in @ref fxp_trig: a value x represents x*pi
+ * radians, both for @ref frac and @ref dfrac angles (in the latter case, the
+ * angle is taken modulo 2, that is, modulo 2*pi). Angles returned by these
+ * functions are in [-1, 1).
+ *
+ * The CORDIC iterations use 32 bit integers and shifts only. The gain of the
+ * algorithm is compensated by scaling the input with a single multiplication,
+ * so the results have the right magnitude. Magnitudes greater than the range
+ * of the output type are saturated.
+ *
+ * The number of iterations is a trade-off between speed and accuracy. The
+ * frac functions do FXP_CORDIC_ITER iterations (default 18), with an error
+ * below 1 LSB; 16 iterations give an error of about 1.5 LSB. The dfrac
+ * functions do CORDIC_MAX_ITER iterations and have an error of about 2**-24.
+ * The conversions to polar coordinates scale x and y by a common power of 2
+ * first, so the error of the angle (about 10 LSB of a dfrac) does not grow
+ * for small vectors. df_cordic_polar and df_cordic_rotate take the number of
+ * iterations as an argument. FXP_CORDIC_ITER must be defined when building the
+ * library.
+ */
+
+/** Maximum number of CORDIC iterations. */
+#define CORDIC_MAX_ITER 30
+
+/**
+ * Arc tangent of y/x, in the right quadrant.
+ *
+ * The result is 0 if both x and y are 0.
+ *
+ * @return	Angle of the vector (x, y), in units of pi radians.
+ */
+frac f_atan2(frac y, frac x);
+
+/**
+ * Magnitude of the vector (x, y), saturated.
+ */
+frac f_hypot(frac x, frac y);
+
+/**
+ * Convert rectangular coordinates to polar.
+ *
+ * @param	x	X coordinate.
+ * @param	y	Y coordinate.
+ * @param	r	Output: magnitude (saturated).
+ * @param	a	Output: angle, in units of pi radians.
+ */
+void f_to_polar(frac x, frac y, frac *r, frac *a);
+
+/**
+ * Convert polar coordinates to rectangular.
+ *
+ * @param	r	Magnitude.
+ * @param	a	Angle, in units of pi radians.
+ * @param	x	Output: X coordinate.
+ * @param	y	Output: Y coordinate.
+ */
+void f_from_polar(frac r, frac a, frac *x, frac *y);
+
+/**
+ * Rotate the vector (x, y), in place, counterclockwise.
+ *
+ * The result is saturated if the magnitude of the vector is greater than 1.
+ *
+ * @param	x	X coordinate.
+ * @param	y	Y coordinate.
+ * @param	a	Angle, in units of pi radians.
+ */
+void f_rotate(frac *x, frac *y, frac a);
+
+/** Double precision version of @ref f_atan2. */
+dfrac df_atan2(dfrac y, dfrac x);
+
+/** Double precision version of @ref f_hypot. */
+dfrac df_hypot(dfrac x, dfrac y);
+
+/** Double precision version of @ref f_to_polar. */
+void df_to_polar(dfrac x, dfrac y, dfrac *r, dfrac *a);
+
+/** Double precision version of @ref f_from_polar. */
+void df_from_polar(dfrac r, dfrac a, dfrac *x, dfrac *y);
+
+/** Double precision version of @ref f_rotate. */
+void df_rotate(dfrac *x, dfrac *y, dfrac a);
+
+/**
+ * Convert rectangular coordinates to polar with the given number of
+ * iterations.
+ *
+ * Each iteration adds about one bit of precision to the angle.
+ *
+ * @param	x	X coordinate.
+ * @param	y	Y coordinate.
+ * @param	r	Output: magnitude (saturated).
+ * @param	a	Output: angle, in units of pi radians.
+ * @param	iter	Number of iterations, between 1 and CORDIC_MAX_ITER.
+ */
+void df_cordic_polar(dfrac x, dfrac y, dfrac *r, dfrac *a, int iter);
+
+/**
+ * Rotate the vector (x, y) with the given number of iterations.
+ *
+ * @param	x	X coordinate.
+ * @param	y	Y coordinate.
+ * @param	a	Angle, in units of pi radians.
+ * @param	iter	Number of iterations, between 1 and CORDIC_MAX_ITER.
+ */
+void df_cordic_rotate(dfrac *x, dfrac *y, dfrac a, int iter);
+
+/** Array version of @ref f_atan2. */
+void f_atan2_n(frac *dst, const frac *y, const frac *x, size_t n);
+
+/** Array version of @ref f_hypot. */
+void f_hypot_n(frac *dst, const frac *x, const frac *y, size_t n);
+
+/** Array version of @ref f_to_polar. */
+void f_to_polar_n(frac *r, frac *a, const frac *x, const frac *y, size_t n);
+
+/** Array version of @ref f_from_polar. */
+void f_from_polar_n(frac *x, frac *y, const frac *r, const frac *a, size_t n);
+
+/** Array version of @ref f_rotate. */
+void f_rotate_n(frac *x, frac *y, const frac *a, size_t n);
+
+/** @}
+ */
+
+#endif /* FXP_CORDIC_H */
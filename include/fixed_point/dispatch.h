@@ -0,0 +1,112 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Selection of the instruction set used by the vectorized routines.
+ */
+
+#ifndef FXP_DISPATCH_H
+#define FXP_DISPATCH_H
+
+#include <stdbool.h>
+
+/**
+ * @defgroup fxp_dispatch	Runtime dispatch
+ * @{
+ *
+ * By default, the vectorized kernels are compiled for the instruction set
+ * enabled by the compiler flags (for example, -mavx2) and the library only
+ * runs on processors which support it.
+ *
+ * When the library is built with `make DISPATCH=1` (x86 only), the array,
+ * CORDIC, FFT, filter, AoS/SoA transpose and batch rotation modules are
+ * instead compiled once for every entry of @ref fxp_isa and the best
+ * implementation supported by the processor is selected the first time one of
+ * those functions is called. The remaining code is compiled with the default
+ * flags, which should therefore not enable anything beyond SSE2.
+ *
+ * All implementations produce exactly the same results, so the selection can
+ * be overridden (for example, to test every code path on a single machine)
+ * with @ref fxp_isa_select. The selection is global. Both the automatic
+ * selection and fxp_isa_select are safe with concurrent calls from other
+ * threads, which keep using the previous implementation until they return.
+ */
+
+/**
+ * Instruction sets, from the least to the most capable.
+ */
+typedef enum {
+	FXP_ISA_GENERIC,	/*!< Portable C code, no vector kernels. */
+	FXP_ISA_SSE2,		/*!< 128 bit vectors. */
+	FXP_ISA_AVX2,		/*!< 256 bit vectors. */
+	FXP_ISA_AVX512,		/*!< AVX2 plus AVX-512 (F and BW). */
+	FXP_ISA_COUNT		/*!< Number of entries, not an instruction set. */
+} fxp_isa;
+
+/**
+ * Name of an instruction set.
+ *
+ * @return	A static string such as "avx2", or NULL if isa is not valid.
+ */
+const char *fxp_isa_name(fxp_isa isa);
+
+/**
+ * Check whether an instruction set can be selected.
+ *
+ * @return	true if the library contains an implementation for isa and the
+ *		processor supports it. Without runtime dispatch, only the
+ *		instruction set the library was compiled for is available.
+ */
+bool fxp_isa_available(fxp_isa isa);
+
+/**
+ * The most capable instruction set that can be selected.
+ */
+fxp_isa fxp_isa_best(void);
+
+/**
+ * The instruction set currently in use.
+ *
+ * Unless overridden with @ref fxp_isa_select, this is @ref fxp_isa_best.
+ */
+fxp_isa fxp_isa_active(void);
+
+/**
+ * Override the instruction set.
+ *
+ * @return	true on success, false if isa is not available (in which case the
+ *		selection is not changed).
+ */
+bool fxp_isa_select(fxp_isa isa);
+
+/** @}
+ */
+
+#endif /* FXP_DISPATCH_H */
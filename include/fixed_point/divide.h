@@ -0,0 +1,116 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Division and reciprocal without hardware division.
+ */
+
+#ifndef FXP_DIVIDE_H
+#define FXP_DIVIDE_H
+
+#include <stddef.h>
+#include "types.h"
+
+/**
+ * @defgroup fxp_div	Division
+ * @{
+ *
+ * Division of fractionals by multiplication with a reciprocal.
+ *
+ * The reciprocal of the divisor is looked up in a table of 128 entries (256
+ * bytes) and refined with one or two Newton-Raphson iterations. Only
+ * multiplications are used, which is faster than a hardware division on most
+ * processors and much faster than a software division on those without one.
+ *
+ * The accuracy is selected with FXP_DIV_ACCURACY when building the library:
+ *
+ * - 2 (default): exact. The result is the same as that of an integer division
+ *   of the scaled dividend (that is, it is truncated towards zero).
+ * - 1: no correction step. The result may be 1 LSB (frac) or 2 LSB (dfrac,
+ *   efrac) smaller in magnitude.
+ * - 0: one Newton-Raphson iteration only. frac results may be 1 LSB smaller
+ *   in magnitude, and 32 bit results have a relative error of about 2**-15.
+ *
+ * Results that do not fit in the output type, including division by zero,
+ * are saturated.
+ */
+
+/**
+ * Divide two fractionals.
+ *
+ * 1.15 / 1.15 => 1.15
+ *
+ * @return	a/b, saturated.
+ */
+frac f_div(frac a, frac b);
+
+/**
+ * Divide two double precision fractionals.
+ *
+ * 2.30 / 2.30 => 2.30
+ *
+ * @return	a/b, saturated.
+ */
+dfrac df_div(dfrac a, dfrac b);
+
+/**
+ * Divide two extended precision fractionals.
+ *
+ * 17.15 / 17.15 => 17.15
+ *
+ * @return	a/b, saturated.
+ */
+efrac ef_div(efrac a, efrac b);
+
+/**
+ * Reciprocal of a fractional.
+ *
+ * The result is always in range, except for x = 0, where it saturates.
+ *
+ * @return	1/x, as an extended fractional.
+ */
+efrac f_recip(frac x);
+
+/** Array version of @ref f_div. */
+void f_div_n(frac *dst, const frac *a, const frac *b, size_t n);
+
+/** Array version of @ref df_div. */
+void df_div_n(dfrac *dst, const dfrac *a, const dfrac *b, size_t n);
+
+/** Array version of @ref ef_div. */
+void ef_div_n(efrac *dst, const efrac *a, const efrac *b, size_t n);
+
+/** Array version of @ref f_recip. */
+void f_recip_n(efrac *dst, const frac *x, size_t n);
+
+/** @}
+ */
+
+#endif /* FXP_DIVIDE_H */
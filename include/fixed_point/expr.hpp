@@ -0,0 +1,273 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Expression templates for fused fixed point arithmetic in C++.
+ */
+
+#ifndef FXP_EXPR_HPP
+#define FXP_EXPR_HPP
+
+#include <type_traits>
+
+#include "q.hpp"
+
+/**
+ * @defgroup fxp_expr	C++ expression templates
+ * @ingroup fxp_cpp
+ * @{
+ *
+ * Sums, differences and products built from @ref fxp::lazy operands are not
+ * evaluated immediately. Instead, they form an expression tree whose exact
+ * result format is known at compile time (see @ref fxp_cpp). When the
+ * expression is assigned to a Q number or to one of the C types, the whole
+ * tree is evaluated with integer arithmetic in the storage type of that
+ * format, and only the final value is rounded (to nearest, ties up) and
+ * saturated.
+ *
+ * Compared to nested calls to the C routines, this saves the intermediate
+ * narrowing and saturation steps and their truncation errors. For example,
+ * the scalar part of @ref q_mul becomes:
+ *
+ * ```
+ * using fxp::lazy;
+ *
+ * s.r = lazy(q.r) * p.r - lazy(q.v.x) * p.v.x
+ *       - lazy(q.v.y) * p.v.y - lazy(q.v.z) * p.v.z;
+ * ```
+ *
+ * which accumulates four exact Q2.30 products in 64 bits and rounds once.
+ *
+ * Operands may be expressions, Q numbers or C fractionals, as long as at least
+ * one of the operands of each operator is an expression. Expressions whose
+ * exact format exceeds 64 bits are rejected at compile time.
+ */
+
+namespace fxp {
+
+namespace expr {
+
+/* Base of all the expression nodes. D must define a format (a Q type) and a
+ * function eval<W>() that yields the raw value in that format, computed in
+ * the integer type W. */
+template <typename D>
+struct node {
+	/** Exact value of the expression. */
+	constexpr auto value() const
+	{
+		using R = typename D::format;
+		using W = typename R::storage;
+
+		return R{static_cast<const D &>(*this).template eval<W>()};
+	}
+
+	/** Value rounded to nearest and saturated to the format R. */
+	template <typename R>
+	constexpr R to() const
+	{
+		return q_round<R>(value());
+	}
+
+	template <int I, int F, typename T>
+	constexpr operator Q<I, F, T>() const
+	{
+		return to<Q<I, F, T>>();
+	}
+
+	constexpr operator mfrac() const { return to_c(to<mfrac_t>()); }
+	constexpr operator frac() const { return to_c(to<frac_t>()); }
+	constexpr operator dfrac() const { return to_c(to<dfrac_t>()); }
+	constexpr operator efrac() const { return to_c(to<efrac_t>()); }
+	constexpr operator lfrac() const { return to_c(to<lfrac_t>()); }
+};
+
+template <typename Qt>
+struct leaf : node<leaf<Qt>> {
+	using format = Qt;
+
+	Qt x;
+
+	constexpr explicit leaf(Qt x_) : x(x_) {}
+
+	template <typename W>
+	constexpr W eval() const
+	{
+		return (W)x.v;
+	}
+};
+
+template <typename A, typename B>
+struct add : node<add<A, B>> {
+	using format = sum_t<typename A::format, typename B::format>;
+
+	A a;
+	B b;
+
+	constexpr add(A a_, B b_) : a(a_), b(b_) {}
+
+	template <typename W>
+	constexpr W eval() const
+	{
+		return detail::scale<W>(a.template eval<W>(), format::frac_bits
+					- A::format::frac_bits)
+		     + detail::scale<W>(b.template eval<W>(), format::frac_bits
+					- B::format::frac_bits);
+	}
+};
+
+template <typename A, typename B>
+struct sub : node<sub<A, B>> {
+	using format = sum_t<typename A::format, typename B::format>;
+
+	A a;
+	B b;
+
+	constexpr sub(A a_, B b_) : a(a_), b(b_) {}
+
+	template <typename W>
+	constexpr W eval() const
+	{
+		return detail::scale<W>(a.template eval<W>(), format::frac_bits
+					- A::format::frac_bits)
+		     - detail::scale<W>(b.template eval<W>(), format::frac_bits
+					- B::format::frac_bits);
+	}
+};
+
+template <typename A, typename B>
+struct mul : node<mul<A, B>> {
+	using format = product_t<typename A::format, typename B::format>;
+
+	A a;
+	B b;
+
+	constexpr mul(A a_, B b_) : a(a_), b(b_) {}
+
+	template <typename W>
+	constexpr W eval() const
+	{
+		return a.template eval<W>() * b.template eval<W>();
+	}
+};
+
+template <typename A>
+struct neg : node<neg<A>> {
+	using format = neg_t<typename A::format>;
+
+	A a;
+
+	constexpr explicit neg(A a_) : a(a_) {}
+
+	template <typename W>
+	constexpr W eval() const
+	{
+		return -a.template eval<W>();
+	}
+};
+
+/* Every sub-expression has a format no wider than that of its parent, so
+ * evaluating the whole tree in the storage of the root cannot overflow. */
+
+template <typename X>
+struct is_node : std::is_base_of<node<X>, X> {};
+
+/* Conversion of operands to nodes */
+
+template <typename X>
+constexpr const X &to_node(const node<X> &x)
+{
+	return static_cast<const X &>(x);
+}
+
+template <int I, int F, typename T>
+constexpr leaf<Q<I, F, T>> to_node(Q<I, F, T> x)
+{
+	return leaf<Q<I, F, T>>(x);
+}
+
+constexpr leaf<mfrac_t> to_node(mfrac x) { return leaf<mfrac_t>(from_c(x)); }
+constexpr leaf<frac_t> to_node(frac x) { return leaf<frac_t>(from_c(x)); }
+constexpr leaf<dfrac_t> to_node(dfrac x) { return leaf<dfrac_t>(from_c(x)); }
+constexpr leaf<efrac_t> to_node(efrac x) { return leaf<efrac_t>(from_c(x)); }
+constexpr leaf<lfrac_t> to_node(lfrac x) { return leaf<lfrac_t>(from_c(x)); }
+
+template <typename X>
+using node_t = typename std::decay<decltype(to_node(std::declval<X>()))>::type;
+
+template <typename A, typename B>
+using enable_binary = typename std::enable_if<
+	is_node<A>::value || is_node<B>::value, int>::type;
+
+template <typename A, typename B, enable_binary<A, B> = 0>
+constexpr add<node_t<A>, node_t<B>> operator+(const A &a, const B &b)
+{
+	return add<node_t<A>, node_t<B>>(to_node(a), to_node(b));
+}
+
+template <typename A, typename B, enable_binary<A, B> = 0>
+constexpr sub<node_t<A>, node_t<B>> operator-(const A &a, const B &b)
+{
+	return sub<node_t<A>, node_t<B>>(to_node(a), to_node(b));
+}
+
+template <typename A, typename B, enable_binary<A, B> = 0>
+constexpr mul<node_t<A>, node_t<B>> operator*(const A &a, const B &b)
+{
+	return mul<node_t<A>, node_t<B>>(to_node(a), to_node(b));
+}
+
+template <typename A, typename std::enable_if<is_node<A>::value, int>::type = 0>
+constexpr neg<A> operator-(const A &a)
+{
+	return neg<A>(a);
+}
+
+} /* namespace expr */
+
+/** Start an expression from a Q number. */
+template <int I, int F, typename T>
+constexpr expr::leaf<Q<I, F, T>> lazy(Q<I, F, T> x)
+{
+	return expr::to_node(x);
+}
+
+/** Start an expression from a C fractional. */
+constexpr expr::leaf<mfrac_t> lazy(mfrac x) { return expr::to_node(x); }
+constexpr expr::leaf<frac_t> lazy(frac x) { return expr::to_node(x); }
+constexpr expr::leaf<dfrac_t> lazy(dfrac x) { return expr::to_node(x); }
+constexpr expr::leaf<efrac_t> lazy(efrac x) { return expr::to_node(x); }
+constexpr expr::leaf<lfrac_t> lazy(lfrac x) { return expr::to_node(x); }
+
+} /* namespace fxp */
+
+/** @}
+ */
+
+#endif /* FXP_EXPR_HPP */
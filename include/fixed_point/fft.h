@@ -0,0 +1,159 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Fast Fourier Transform of fractional data.
+ */
+
+#ifndef FXP_FFT_H
+#define FXP_FFT_H
+
+#include <stddef.h>
+#include "types.h"
+
+/**
+ * @defgroup fxp_fft	FFT
+ * @{
+ *
+ * In-place radix-2 decimation in time FFT for complex @ref frac data.
+ *
+ * To avoid overflows, the result of each stage is divided by 2 (with
+ * convergent rounding), so the result of a transform of n points is scaled by
+ * 1/n:
+ *
+ *         X[k] = (1/n) * sum(x[i] * exp(-2*pi*j*i*k/n))
+ *
+ * The inverse transform is scaled in the same way, so ifft(fft(x)) is x/n
+ * plus rounding errors. Since the magnitude of a complex frac can be greater
+ * than one, the outputs of the first stage are saturated in the (unlikely)
+ * case they do not fit.
+ *
+ * The twiddle factors are stored as fracs, grouped by stage, so every stage
+ * reads them sequentially. On x86 the butterflies of stages with at least one
+ * vector of twiddles are computed with pmaddwd.
+ *
+ * FFT objects do not allocate memory: the twiddle tables are provided by the
+ * caller and can be shared by any number of transforms of the same size.
+ * The twiddles are computed with @ref f_sincos, so no floating point is used,
+ * and they have the same error (about 1 LSB, see @ref fxp_trig).
+ */
+
+/**
+ * Complex number with @ref frac components.
+ */
+typedef struct {
+	frac re;	/*!< Real part */
+	frac im;	/*!< Imaginary part */
+} cfrac;
+
+/**
+ * Calculate the number of elements of the twiddle table for an n point FFT.
+ */
+#define FFT_TWIDDLE_LEN(n) (n)
+
+/**
+ * Calculate the number of elements of the twiddle table for an n point real
+ * FFT.
+ */
+#define RFFT_TWIDDLE_LEN(n) ((n)/2 + (n)/4 + 1)
+
+/**
+ * Complex FFT plan.
+ */
+typedef struct {
+	const cfrac *tw;	/*!< Twiddle factors, FFT_TWIDDLE_LEN(n) */
+	size_t n;		/*!< Number of points */
+} fft_f;
+
+/**
+ * Real FFT plan.
+ */
+typedef struct {
+	fft_f half;		/*!< Complex FFT of n/2 points */
+	const cfrac *tw;	/*!< Twiddle factors for the final pass */
+	size_t n;		/*!< Number of points */
+} rfft_f;
+
+/**
+ * Initialize a complex FFT plan.
+ *
+ * @param	f	FFT plan.
+ * @param	twiddle	Array of FFT_TWIDDLE_LEN(n) elements.
+ * @param	n	Number of points. Must be a power of 2, at most 65536.
+ */
+void fft_init(fft_f *f, cfrac *twiddle, size_t n);
+
+/**
+ * Forward complex FFT, in place.
+ *
+ * @param	f	FFT plan.
+ * @param	x	Array of n elements.
+ */
+void fft(const fft_f *f, cfrac *x);
+
+/**
+ * Inverse complex FFT, in place.
+ *
+ * @param	f	FFT plan (the same as for the forward transform).
+ * @param	x	Array of n elements.
+ */
+void ifft(const fft_f *f, cfrac *x);
+
+/**
+ * Initialize a real FFT plan.
+ *
+ * @param	f	FFT plan.
+ * @param	twiddle	Array of RFFT_TWIDDLE_LEN(n) elements.
+ * @param	n	Number of points. Must be a power of 2, between 4 and
+ * 			65536.
+ */
+void rfft_init(rfft_f *f, cfrac *twiddle, size_t n);
+
+/**
+ * Forward FFT of real data.
+ *
+ * Computes a complex FFT of n/2 points and then splits the result. The scale
+ * is the same as for the complex FFT (1/n).
+ *
+ * Only the first half of the spectrum is returned, since the rest is its
+ * complex conjugate. Bins 0 and n/2 are real, so the real part of bin n/2 is
+ * stored in the imaginary part of bin 0.
+ *
+ * @param	f	FFT plan.
+ * @param	out	Array of n/2 complex elements. It may be the same memory
+ * 			as in.
+ * @param	in	Array of n real elements.
+ */
+void rfft(const rfft_f *f, cfrac *out, const frac *in);
+
+/** @}
+ */
+
+#endif /* FXP_FFT_H */
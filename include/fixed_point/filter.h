@@ -0,0 +1,230 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Digital filters for fractional signals.
+ *
+ * Filter objects do not allocate memory. The caller provides the storage for
+ * the coefficients and the state, which must remain valid for as long as the
+ * filter is used.
+ */
+
+#ifndef FXP_FILTER_H
+#define FXP_FILTER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "types.h"
+
+/**
+ * @defgroup fxp_filter	Filters
+ * @{
+ */
+
+/**
+ * @defgroup fxp_fir	FIR filters
+ * @{
+ *
+ * Finite impulse response filter with frac input, output and coefficients.
+ *
+ * The output is
+ *
+ *         y[n] = sum(h[k] * x[n-k]),  k = 0 ... ntaps-1
+ *
+ * The sum is saturated to a @ref dfrac, and then converted to a frac with
+ * convergent rounding (see @ref df_to_f_cr). If the sum of the absolute values
+ * of the coefficients is less than 2, the sum can never overflow and it is
+ * accumulated in 32 bits. Otherwise, a 64 bit accumulator is used.
+ *
+ * The history is kept in a circular buffer where every sample is stored twice,
+ * so that the last ntaps samples are always contiguous in memory and the inner
+ * loop is a plain dot product. The buffer holds FIR_BLOCK samples more than
+ * needed, so that the samples of a whole block are stored before the outputs
+ * are calculated (reading back a sample that was just stored is slow on
+ * most processors).
+ *
+ * Filters with 8, 16, 32 and 64 taps use specialized code paths. On x86,
+ * when the sum is accumulated in 32 bits, 8 or 16 consecutive outputs are
+ * computed at a time, applying each pair of taps to a vector of samples,
+ * instead of a dot product per output.
+ */
+
+/**
+ * Number of samples processed at a time by @ref fir_process.
+ */
+#define FIR_BLOCK 32
+
+/**
+ * Calculate the number of elements of the state buffer for a FIR filter.
+ *
+ * The number of taps is rounded up to a multiple of 16, so that the vector
+ * code, which computes up to 16 outputs at a time, stays in step with the
+ * wrap-around of the circular buffer.
+ */
+#define FIR_STATE_LEN(ntaps) (2 * (((ntaps) + 15) / 16 * 16 + FIR_BLOCK))
+
+/**
+ * FIR filter state.
+ *
+ * The members should not be accessed directly.
+ */
+typedef struct {
+	const frac *coef;	/*!< Coefficients, h[0] first */
+	frac *hist;		/*!< Circular buffer, FIR_STATE_LEN(ntaps) */
+	size_t ntaps;		/*!< Number of coefficients */
+	size_t pos;		/*!< Position of the newest sample in hist */
+	size_t len;		/*!< Length of the circular buffer */
+	bool wide;		/*!< The sum may not fit in 32 bits */
+} fir_f;
+
+/**
+ * Initialize a FIR filter.
+ *
+ * The history is cleared (set to zero).
+ *
+ * @param	f	Filter object.
+ * @param	coef	Array of ntaps coefficients. It is not copied.
+ * @param	state	Array of FIR_STATE_LEN(ntaps) elements.
+ * @param	ntaps	Number of coefficients. Must be at least 1.
+ */
+void fir_init(fir_f *f, const frac *coef, frac *state, size_t ntaps);
+
+/**
+ * Clear the history of a FIR filter.
+ */
+void fir_reset(fir_f *f);
+
+/**
+ * Filter a block of samples.
+ *
+ * The filter state is preserved between calls, so a signal can be processed
+ * in blocks of any size.
+ *
+ * @param	f	Filter object.
+ * @param	out	Output array of n elements. May be the same as in.
+ * @param	in	Input array of n elements.
+ * @param	n	Number of samples.
+ */
+void fir_process(fir_f *f, frac *out, const frac *in, size_t n);
+
+/** @}
+ */
+
+/**
+ * @defgroup fxp_biquad	Biquad (IIR) filters
+ * @{
+ *
+ * Cascade of second order sections (biquads) in transposed direct form II.
+ * Each section computes
+ *
+ *         y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] - a1*y[n-1] - a2*y[n-2]
+ *
+ * Since the feedback coefficients of a stable biquad can be as large as 2, all
+ * coefficients are stored divided by 2**shift. The output of each section is
+ * multiplied back by 2**shift.
+ *
+ * The state of each section is kept in two @ref dfrac accumulators, which are
+ * updated with saturating operations. Only the output of each section is
+ * rounded to a frac (with convergent rounding) and saturated.
+ *
+ * A filter can process many channels with the same coefficients. The samples
+ * of all channels are interleaved: sample n of channel c is at
+ * x[n*nch + c]. The SIMD kernels process a group of channels in each vector.
+ */
+
+/**
+ * Maximum value for the coefficient shift of a biquad filter.
+ */
+#define BIQUAD_MAX_SHIFT (FRAC_FBIT - 1)
+
+/**
+ * Calculate the number of elements of the state buffer for a biquad cascade.
+ */
+#define BIQUAD_STATE_LEN(nstages, nch) (2 * (nstages) * (nch))
+
+/**
+ * Coefficients of a second order section, divided by 2**shift.
+ */
+typedef struct {
+	frac b0, b1, b2;	/*!< Numerator (feed-forward) coefficients */
+	frac a1, a2;		/*!< Denominator (feedback) coefficients */
+} biquad_coef;
+
+/**
+ * Biquad cascade filter state.
+ *
+ * The members should not be accessed directly.
+ */
+typedef struct {
+	const biquad_coef *coef;	/*!< Coefficients, one set per stage */
+	dfrac *state;		/*!< BIQUAD_STATE_LEN(nstages, nch) */
+	size_t nstages;		/*!< Number of second order sections */
+	size_t nch;		/*!< Number of interleaved channels */
+	int shift;		/*!< Coefficient scale */
+} biquad_f;
+
+/**
+ * Initialize a biquad cascade.
+ *
+ * The state is cleared (set to zero).
+ *
+ * @param	f	Filter object.
+ * @param	coef	Array of nstages sets of coefficients. It is not copied.
+ * @param	state	Array of BIQUAD_STATE_LEN(nstages, nch) elements.
+ * @param	nstages	Number of second order sections. Must be at least 1.
+ * @param	nch	Number of channels. Must be at least 1.
+ * @param	shift	The coefficients are divided by 2**shift. Must be
+ * 			between 0 and BIQUAD_MAX_SHIFT.
+ */
+void biquad_init(biquad_f *f, const biquad_coef *coef, dfrac *state,
+		 size_t nstages, size_t nch, int shift);
+
+/**
+ * Clear the state of a biquad cascade.
+ */
+void biquad_reset(biquad_f *f);
+
+/**
+ * Filter a block of samples.
+ *
+ * @param	f	Filter object.
+ * @param	out	Output array of n*nch elements. May be the same as in.
+ * @param	in	Input array of n*nch interleaved samples.
+ * @param	n	Number of samples per channel.
+ */
+void biquad_process(biquad_f *f, frac *out, const frac *in, size_t n);
+
+/** @}
+ */
+
+/** @}
+ */
+
+#endif /* FXP_FILTER_H */
@@ -46,6 +46,7 @@
 #include <stdbool.h>
 #include "common.h"
 #include "types.h"
+#include "telemetry.h"
 
 /** @defgroup fxp_fmacros	Function-generating macros
  * @{
@@ -96,6 +97,25 @@ FXP_DECLARATION(typeR name(typeA a, typeB b)) \
  */
 #define FXP_OP3(name, typeRAB, op) FXP_OP2(name, typeRAB, typeRAB, typeRAB, op)
 
+/**
+ * Define an addition or a substraction that may overflow.
+ *
+ * Same as FXP_OP3, but the overflows are counted in telemetry builds.
+ *
+ * @param	name	Name of the function.
+ * @param	typeRAB	Type of first and second argument and also return type.
+ * @param	op	Operator, + or -.
+ * @param	ovf	Overflow predicate, FXP_TM_ADD_OVF or FXP_TM_SUB_OVF.
+ * @param	LIM	Prefix of the limits of the type, as in FRAC_MAX_V.
+ */
+#define FXP_OP3_OVF(name, typeRAB, op, ovf, LIM) \
+FXP_DECLARATION(typeRAB name(typeRAB a, typeRAB b)) \
+{ \
+	typeRAB r = {a.v op b.v}; \
+	FXP_TM(name, ovf(a.v, b.v, LIM##_MIN_V, LIM##_MAX_V)); \
+	return r; \
+}
+
 /**
  * Define a comparation function (frac).
  *
@@ -130,6 +150,28 @@ FXP_DECLARATION(typeR name(typeA a, typeB b)) \
  */
 #define F_SIGN(a) (((a).v >= 0)? 1 : -1)
 
+/** @}
+ * @defgroup fxp_divider	Integer divider
+ * @{
+ */
+
+/**
+ * Precomputed division by an integer.
+ *
+ * A division by a constant integer can be done as a multiplication by a
+ * "magic number" followed by a shift. When the same divisor is used many
+ * times, it is worth precomputing that number with @ref idiv_init and using
+ * f_idivd, df_idivd, ef_idivd or their vector and array versions.
+ *
+ * The results are exactly the same as those of f_idiv, df_idiv and ef_idiv.
+ */
+typedef struct {
+	uint32_t m;	/*!< Magic number for 32 bit dividends */
+	uint16_t m16;	/*!< Magic number for 16 bit dividends */
+	uint8_t shift;	/*!< ceil(log2(|divisor|)) */
+	bool neg;	/*!< The divisor is negative */
+} idivider;
+
 /** @}
  */
 
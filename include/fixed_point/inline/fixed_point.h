@@ -48,6 +48,7 @@
  * so one may have inlining and optimizations.
  */
 
+#include <limits.h>
 #include <stdbool.h>
 #include "../fixed_point.h"
 
@@ -156,26 +157,33 @@ FXP_DCMP(df_eq, ==)
  */
 
 /** Add two single precision fractional numbers - may overflow. */
-FXP_OP3(f_add, frac, +)
+FXP_OP3_OVF(f_add, frac, +, FXP_TM_ADD_OVF, FRAC)
 
 /** Substract two single precision fractional numbers - may overflow. */
-FXP_OP3(f_sub, frac, -)
+FXP_OP3_OVF(f_sub, frac, -, FXP_TM_SUB_OVF, FRAC)
 
 /** Add two double precision fractional numbers - may overflow. */
-FXP_OP3(df_add, dfrac, +)
+FXP_OP3_OVF(df_add, dfrac, +, FXP_TM_ADD_OVF, DFRAC)
 
 /** Substract two double precision fractional numbers - may overflow. */
-FXP_OP3(df_sub, dfrac, -)
+FXP_OP3_OVF(df_sub, dfrac, -, FXP_TM_SUB_OVF, DFRAC)
 
 /** Add two extended precision fractional numbers - may overflow. */
-FXP_OP3(ef_add, efrac, +)
+FXP_OP3_OVF(ef_add, efrac, +, FXP_TM_ADD_OVF, EFRAC)
 
 /** Substract two extended precision fractional numbers - may overflow. */
-FXP_OP3(ef_sub, efrac, -)
+FXP_OP3_OVF(ef_sub, efrac, -, FXP_TM_SUB_OVF, EFRAC)
+
+/** Add two long fractional numbers. */
+FXP_OP3_OVF(lf_add, lfrac, +, FXP_TM_ADD_OVF, LFRAC)
+
+/** Substract two long fractional numbers. */
+FXP_OP3_OVF(lf_sub, lfrac, -, FXP_TM_SUB_OVF, LFRAC)
 
 /** Add a single precision fractional to an extended precision fractional. */
 FXP_DECLARATION(efrac ef_f_add(efrac a, frac b))
 {
+	FXP_TM(ef_f_add, FXP_TM_ADD_OVF(a.v, b.v, EFRAC_MIN_V, EFRAC_MAX_V));
 	a.v += b.v;
 	return a;
 }
@@ -184,6 +192,7 @@ FXP_DECLARATION(efrac ef_f_add(efrac a, frac b))
 FXP_DECLARATION(frac f_neg(frac a))
 {
 	frac r = {-a.v};
+	FXP_TM(f_neg, a.v == FRAC_MIN_V);
 	return r;
 }
 
@@ -191,6 +200,7 @@ FXP_DECLARATION(frac f_neg(frac a))
 FXP_DECLARATION(dfrac df_neg(dfrac a))
 {
 	dfrac r = {-a.v};
+	FXP_TM(df_neg, a.v == DFRAC_MIN_V);
 	return r;
 }
 
@@ -198,6 +208,7 @@ FXP_DECLARATION(dfrac df_neg(dfrac a))
 FXP_DECLARATION(efrac ef_neg(efrac a))
 {
 	efrac r = {-a.v};
+	FXP_TM(ef_neg, a.v == EFRAC_MIN_V);
 	return r;
 }
 
@@ -214,6 +225,7 @@ FXP_DECLARATION(efrac ef_neg(efrac a))
 FXP_DECLARATION(frac f_mul(frac a, frac b))
 {
 	frac r = {((((dfrac_base)a.v) * b.v) << 1) >> FRAC_BIT};
+	FXP_TM(f_mul, a.v == FRAC_MIN_V && b.v == FRAC_MIN_V);
 	return r;
 }
 
@@ -257,6 +269,7 @@ FXP_DECLARATION(efrac f_mf_mul_ef(frac a, mfrac b))
 FXP_DECLARATION(frac f_imul(frac a, int16_t b))
 {
 	frac r = { a.v * b };
+	FXP_TM(f_imul, FXP_TM_OUT((int32_t)a.v * b, FRAC_MIN_V, FRAC_MAX_V));
 	return r;
 }
 
@@ -271,6 +284,7 @@ FXP_DECLARATION(frac f_imul(frac a, int16_t b))
  */
 FXP_DECLARATION(int f_imul_i(frac a, int b))
 {
+	FXP_TM(f_imul_i, FXP_TM_OUT((((int64_t)b)*a.v) >> 15, INT_MIN, INT_MAX));
 	return (((int64_t)b)*a.v) >> 15;
 }
 
@@ -301,6 +315,7 @@ FXP_DECLARATION(efrac f_imul_ef(frac a, int16_t b))
 FXP_DECLARATION(dfrac df_imul(dfrac a, int16_t b))
 {
 	dfrac r = { a.v * b };
+	FXP_TM(df_imul, FXP_TM_OUT((int64_t)a.v * b, DFRAC_MIN_V, DFRAC_MAX_V));
 	return r;
 }
 
@@ -316,6 +331,7 @@ FXP_DECLARATION(dfrac df_imul(dfrac a, int16_t b))
 FXP_DECLARATION(efrac ef_imul(efrac a, int16_t b))
 {
 	efrac r = { a.v * b };
+	FXP_TM(ef_imul, FXP_TM_OUT((int64_t)a.v * b, EFRAC_MIN_V, EFRAC_MAX_V));
 	return r;
 }
 
@@ -331,6 +347,7 @@ FXP_DECLARATION(efrac ef_imul(efrac a, int16_t b))
 FXP_DECLARATION(frac f_idiv(frac a, int16_t b))
 {
 	frac r = { a.v / b };
+	FXP_TM(f_idiv, a.v == FRAC_MIN_V && b == -1);
 	return r;
 }
 
@@ -346,6 +363,7 @@ FXP_DECLARATION(frac f_idiv(frac a, int16_t b))
 FXP_DECLARATION(dfrac df_idiv(dfrac a, int16_t b))
 {
 	dfrac r = { a.v / b };
+	FXP_TM(df_idiv, a.v == DFRAC_MIN_V && b == -1);
 	return r;
 }
 
@@ -361,6 +379,76 @@ FXP_DECLARATION(dfrac df_idiv(dfrac a, int16_t b))
 FXP_DECLARATION(efrac ef_idiv(efrac a, int16_t b))
 {
 	efrac r = { a.v / b };
+	FXP_TM(ef_idiv, a.v == EFRAC_MIN_V && b == -1);
+	return r;
+}
+
+/**
+ * Prepare a divider for dividing by an integer.
+ *
+ * The magic numbers are ceil(2**(l + s) / |b|), with s = ceil(log2(|b|)) and
+ * l = 15 for 16 bit dividends, 31 for 32 bit dividends. With these, the
+ * truncated products are exact for all dividends of the respective size.
+ *
+ * @param	d	Divider.
+ * @param	b	Divisor. Must not be zero.
+ */
+FXP_DECLARATION(void idiv_init(idivider *d, int16_t b))
+{
+	uint32_t ub = (b < 0)? -(uint32_t)b : (uint32_t)b;
+	unsigned int s = 0;
+
+	while (((uint32_t)1 << s) < ub)
+		s++;
+
+	d->m = (uint32_t)(((((uint64_t)1 << (31 + s)) - 1) / ub) + 1);
+	d->m16 = (uint16_t)(((((uint32_t)1 << (15 + s)) - 1) / ub) + 1);
+	d->shift = (uint8_t)s;
+	d->neg = (b < 0);
+}
+
+/**
+ * Divide single precision by a precomputed integer divider.
+ *
+ * Same as @ref f_idiv, without a division.
+ */
+FXP_DECLARATION(frac f_idivd(frac a, const idivider *d))
+{
+	uint32_t ua = (a.v < 0)? -(uint32_t)a.v : (uint32_t)a.v;
+	uint32_t q = (ua * d->m16) >> (FRAC_FBIT + d->shift);
+	frac r = {(frac_base)(((a.v < 0) != d->neg)? 0u - q : q)};
+
+	FXP_TM(f_idivd, a.v == FRAC_MIN_V && d->neg && d->shift == 0);
+	return r;
+}
+
+/**
+ * Divide double precision by a precomputed integer divider.
+ *
+ * Same as @ref df_idiv, without a division.
+ */
+FXP_DECLARATION(dfrac df_idivd(dfrac a, const idivider *d))
+{
+	uint32_t ua = (a.v < 0)? -(uint32_t)a.v : (uint32_t)a.v;
+	uint32_t q = (uint32_t)(((uint64_t)ua * d->m) >> (31 + d->shift));
+	dfrac r = {(dfrac_base)(((a.v < 0) != d->neg)? 0u - q : q)};
+
+	FXP_TM(df_idivd, a.v == DFRAC_MIN_V && d->neg && d->shift == 0);
+	return r;
+}
+
+/**
+ * Divide extended precision by a precomputed integer divider.
+ *
+ * Same as @ref ef_idiv, without a division.
+ */
+FXP_DECLARATION(efrac ef_idivd(efrac a, const idivider *d))
+{
+	uint32_t ua = (a.v < 0)? -(uint32_t)a.v : (uint32_t)a.v;
+	uint32_t q = (uint32_t)(((uint64_t)ua * d->m) >> (31 + d->shift));
+	efrac r = {(efrac_base)(((a.v < 0) != d->neg)? 0u - q : q)};
+
+	FXP_TM(ef_idivd, a.v == EFRAC_MIN_V && d->neg && d->shift == 0);
 	return r;
 }
 
@@ -375,6 +463,7 @@ FXP_DECLARATION(efrac ef_idiv(efrac a, int16_t b))
 FXP_DECLARATION(dfrac df_shiftl(dfrac a, int16_t b))
 {
 	dfrac r = { a.v << b };
+	FXP_TM(df_shiftl, (a.v >> (DFRAC_BIT - 1 - b)) != (a.v >> (DFRAC_BIT - 1)));
 	return r;
 }
 
@@ -407,6 +496,8 @@ FXP_DECLARATION(frac df_to_f(dfrac x))
 { /* 2.30 -> 1.15 */
 	frac r;
 
+	FXP_TM(df_to_f, x.v >= DFRAC_1_V || x.v < DFRAC_minus1_V);
+
 	if (x.v >= DFRAC_1_V)
 		r.v = FRAC_1_V;
 	else if ( x.v < DFRAC_minus1_V)
@@ -431,6 +522,71 @@ FXP_DECLARATION(dfrac f_to_df(frac x))
 	return r;
 }
 
+/**
+ * Extend a single precision fractional to a long fractional.
+ */
+FXP_DECLARATION(lfrac f_to_lf(frac x))
+{
+	lfrac r = {((lfrac_base)x.v) * (1 << (LFRAC_FBIT - FRAC_FBIT))};
+	return r;
+}
+
+/**
+ * Extend a double precision fractional to a long fractional.
+ */
+FXP_DECLARATION(lfrac df_to_lf(dfrac x))
+{
+	lfrac r = {x.v};
+	return r;
+}
+
+/**
+ * Saturate a long fractional to yield a double precision fractional.
+ *
+ * Both types have the same precision, so no rounding is involved.
+ */
+FXP_DECLARATION(dfrac lf_to_df(lfrac x))
+{
+	dfrac r = {(x.v > DFRAC_MIN_V)?
+			((x.v < DFRAC_MAX_V)? (dfrac_base)x.v : DFRAC_MAX_V)
+			: DFRAC_MIN_V
+		};
+	FXP_TM(lf_to_df, FXP_TM_OUT(x.v, DFRAC_MIN_V, DFRAC_MAX_V));
+	return r;
+}
+
+/**
+ * Truncate a long fractional to single precision, with saturation.
+ *
+ * @see	df_to_f
+ */
+FXP_DECLARATION(frac lf_to_f(lfrac x))
+{
+	lfrac_base q = x.v >> (LFRAC_FBIT - FRAC_FBIT);
+	frac r = {(q > FRAC_MIN_V)? ((q < FRAC_MAX_V)? (frac_base)q : FRAC_MAX_V)
+				  : FRAC_MIN_V};
+	FXP_TM(lf_to_f, FXP_TM_OUT(q, FRAC_MIN_V, FRAC_MAX_V));
+
+	return r;
+}
+
+/**
+ * Round a long fractional to single precision, with saturation.
+ *
+ * Ties are rounded up (towards +infinity), as in @ref df_to_f_r.
+ */
+FXP_DECLARATION(frac lf_to_f_r(lfrac x))
+{
+	lfrac_base h = x.v >> (LFRAC_FBIT - FRAC_FBIT - 1);
+	/* Adding the last bit after the shift cannot overflow */
+	lfrac_base q = (h >> 1) + (h & 1);
+	frac r = {(q > FRAC_MIN_V)? ((q < FRAC_MAX_V)? (frac_base)q : FRAC_MAX_V)
+				  : FRAC_MIN_V};
+	FXP_TM(lf_to_f_r, FXP_TM_OUT(q, FRAC_MIN_V, FRAC_MAX_V));
+
+	return r;
+}
+
 /**
  * Extend a single precision fractional to an extended-fractional
  */
@@ -465,6 +621,7 @@ FXP_DECLARATION(frac ef_to_f(efrac x))
 			((x.v < FRAC_1_V)? x.v : FRAC_1_V)
 			: FRAC_minus1_V
 		};
+	FXP_TM(ef_to_f, FXP_TM_OUT(x.v, FRAC_MIN_V, FRAC_MAX_V));
 	return r;
 }
 
@@ -482,6 +639,8 @@ FXP_DECLARATION(frac f_clip (frac x, frac limit))
 
 	frac r = {(x.v > -limit.v)? ((x.v < limit.v)? x.v : limit.v) : -limit.v};
 
+	FXP_TM(f_clip, x.v > limit.v || x.v < -limit.v);
+
 	return r;
 }
 
@@ -495,6 +654,8 @@ FXP_DECLARATION(dfrac df_addsat(dfrac x1, dfrac x2))
 {
 	dfrac r;
 
+	FXP_TM(df_addsat, FXP_TM_ADD_OVF(x1.v, x2.v, DFRAC_MIN_V, DFRAC_MAX_V));
+
 	/* The compiler does not seem to generate nice code for the
 	 * implementation below: */
 
@@ -507,6 +668,210 @@ FXP_DECLARATION(dfrac df_addsat(dfrac x1, dfrac x2))
 	return r;
 }
 
+/**
+ * Substract with saturation.
+ *
+ * @return	If the substraction would result in an overflow, return
+ * 		DFRAC_MAX or DFRAC_MIN. Else, return the difference.
+ */
+FXP_DECLARATION(dfrac df_subsat(dfrac x1, dfrac x2))
+{
+	dfrac r;
+
+	FXP_TM(df_subsat, FXP_TM_SUB_OVF(x1.v, x2.v, DFRAC_MIN_V, DFRAC_MAX_V));
+
+	if (x2.v >= 0)
+		r.v = (x1.v < DFRAC_MIN_V + x2.v)? DFRAC_MIN_V : x1.v - x2.v;
+	else
+		r.v = (x1.v > DFRAC_MAX_V + x2.v)? DFRAC_MAX_V : x1.v - x2.v;
+
+	return r;
+}
+
+/**
+ * Add extended precision fractionals with saturation.
+ *
+ * @see	df_addsat
+ */
+FXP_DECLARATION(efrac ef_addsat(efrac x1, efrac x2))
+{
+	efrac r;
+
+	FXP_TM(ef_addsat, FXP_TM_ADD_OVF(x1.v, x2.v, EFRAC_MIN_V, EFRAC_MAX_V));
+
+	if (x1.v >= 0)
+		r.v = (x2.v > EFRAC_MAX_V - x1.v)? EFRAC_MAX_V : x1.v + x2.v;
+	else
+		r.v = (x2.v < EFRAC_MIN_V - x1.v) ? EFRAC_MIN_V : x1.v + x2.v;
+
+	return r;
+}
+
+/**
+ * Substract extended precision fractionals with saturation.
+ *
+ * @see	df_subsat
+ */
+FXP_DECLARATION(efrac ef_subsat(efrac x1, efrac x2))
+{
+	efrac r;
+
+	FXP_TM(ef_subsat, FXP_TM_SUB_OVF(x1.v, x2.v, EFRAC_MIN_V, EFRAC_MAX_V));
+
+	if (x2.v >= 0)
+		r.v = (x1.v < EFRAC_MIN_V + x2.v)? EFRAC_MIN_V : x1.v - x2.v;
+	else
+		r.v = (x1.v > EFRAC_MAX_V + x2.v)? EFRAC_MAX_V : x1.v - x2.v;
+
+	return r;
+}
+
+/**
+ * Add single precision fractionals with saturation.
+ *
+ * The sum of two fracs always fits in an efrac, so it is computed there and
+ * then saturated.
+ *
+ * @return	If the addition would result in an overflow, return FRAC_MAX or
+ * 		FRAC_MIN. Else, return the sum.
+ */
+FXP_DECLARATION(frac f_addsat(frac a, frac b))
+{
+	FXP_TM(f_addsat, FXP_TM_ADD_OVF(a.v, b.v, FRAC_MIN_V, FRAC_MAX_V));
+	return ef_to_f(ef_add(f_to_ef(a), f_to_ef(b)));
+}
+
+/**
+ * Substract single precision fractionals with saturation.
+ *
+ * @see	f_addsat
+ */
+FXP_DECLARATION(frac f_subsat(frac a, frac b))
+{
+	FXP_TM(f_subsat, FXP_TM_SUB_OVF(a.v, b.v, FRAC_MIN_V, FRAC_MAX_V));
+	return ef_to_f(ef_sub(f_to_ef(a), f_to_ef(b)));
+}
+
+/**
+ * Negate single precision fractional with saturation.
+ *
+ * @return	-a, or FRAC_MAX if a is -1.
+ */
+FXP_DECLARATION(frac f_negsat(frac a))
+{
+	frac r = {(a.v == FRAC_MIN_V)? FRAC_MAX_V : -a.v};
+	FXP_TM(f_negsat, a.v == FRAC_MIN_V);
+	return r;
+}
+
+/**
+ * Multiply single precision with saturation, yield single precision.
+ *
+ * The only product that does not fit in a frac is (-1)*(-1), which yields
+ * FRAC_MAX instead of wrapping to -1 as @ref f_mul does. In all other cases
+ * the result is the same as f_mul.
+ *
+ * @param	a,b	Operands
+ * @return		saturate(a*b)
+ *
+ * @bug		Does not perform convergent rounding.
+ */
+FXP_DECLARATION(frac f_mulsat(frac a, frac b))
+{
+	efrac p = {f_mul_df(a, b).v >> (FRAC_BIT - 1)};
+
+	FXP_TM(f_mulsat, a.v == FRAC_MIN_V && b.v == FRAC_MIN_V);
+	return ef_to_f(p);
+}
+
+/**
+ * Multiply single precision with rounding, yield single precision.
+ *
+ * Same as @ref f_mul, but the product is rounded to the nearest frac, with
+ * ties rounded up (towards +infinity). This is the same operation performed
+ * by the x86 pmulhrsw instruction.
+ *
+ * (-1)*(-1) overflows to -1, as in f_mul.
+ *
+ * @param	a,b	Operands
+ * @return		round(a*b)
+ */
+FXP_DECLARATION(frac f_mul_r(frac a, frac b))
+{
+	dfrac_base p = f_mul_df(a, b).v;
+	frac r = {(p >> (FRAC_BIT - 1)) + ((p >> (FRAC_BIT - 2)) & 1)};
+
+	FXP_TM(f_mul_r, a.v == FRAC_MIN_V && b.v == FRAC_MIN_V);
+	return r;
+}
+
+/**
+ * Multiply single precision with convergent rounding, yield single precision.
+ *
+ * Same as @ref f_mul, but the product is rounded to the nearest frac, with
+ * ties rounded to the nearest even value. Unlike truncation and rounding
+ * towards +infinity, this rounding mode has no bias, so errors do not pile up
+ * in long chains of operations.
+ *
+ * (-1)*(-1) overflows to -1, as in f_mul.
+ *
+ * @param	a,b	Operands
+ * @return		round_even(a*b)
+ */
+FXP_DECLARATION(frac f_mul_cr(frac a, frac b))
+{
+	dfrac_base p = f_mul_df(a, b).v;
+	dfrac_base rem = p & ((1 << (FRAC_BIT - 1)) - 1);
+	dfrac_base q = p >> (FRAC_BIT - 1);
+	frac r;
+
+	if (rem > (1 << (FRAC_BIT - 2)) || (rem == (1 << (FRAC_BIT - 2)) && (q & 1)))
+		q++;
+
+	FXP_TM(f_mul_cr, a.v == FRAC_MIN_V && b.v == FRAC_MIN_V);
+	r.v = q;
+	return r;
+}
+
+/**
+ * Round to single precision.
+ *
+ * Same as @ref df_to_f, but the value is rounded to the nearest frac, with
+ * ties rounded up (towards +infinity).
+ *
+ * @param	x	Double precision fractional
+ * @return		x as a single precision fractional
+ */
+FXP_DECLARATION(frac df_to_f_r(dfrac x))
+{
+	efrac q = {(x.v >> (FRAC_BIT - 1)) + ((x.v >> (FRAC_BIT - 2)) & 1)};
+
+	FXP_TM(df_to_f_r, FXP_TM_OUT(q.v, FRAC_MIN_V, FRAC_MAX_V));
+	return ef_to_f(q);
+}
+
+/**
+ * Round to single precision with convergent rounding.
+ *
+ * Same as @ref df_to_f, but the value is rounded to the nearest frac, with
+ * ties rounded to the nearest even value.
+ *
+ * @param	x	Double precision fractional
+ * @return		x as a single precision fractional
+ */
+FXP_DECLARATION(frac df_to_f_cr(dfrac x))
+{
+	efrac_base rem = x.v & ((1 << (FRAC_BIT - 1)) - 1);
+	efrac q = {x.v >> (FRAC_BIT - 1)};
+
+	if (rem > (1 << (FRAC_BIT - 2))
+	    || (rem == (1 << (FRAC_BIT - 2)) && (q.v & 1)))
+		q.v++;
+
+	FXP_TM(df_to_f_cr, FXP_TM_OUT(q.v, FRAC_MIN_V, FRAC_MAX_V));
+	return ef_to_f(q);
+}
+
 /**
  * Multiply-accumulate with saturation. Use a dfrac as accumulator.
  *
@@ -517,12 +882,35 @@ FXP_DECLARATION(dfrac df_addsat(dfrac x1, dfrac x2))
  * @param	z	Sumand / Accumulator
  *
  * @return		saturateds(z + x*y)
+ *
+ * @see	f_mac_lf, which does not need to saturate.
  */
 FXP_DECLARATION(dfrac f_macs_df (frac x, frac y, dfrac z))
 {
+	FXP_TM(f_macs_df, FXP_TM_ADD_OVF(z.v, f_mul_df(x, y).v,
+					 DFRAC_MIN_V, DFRAC_MAX_V));
 	return df_addsat(z, f_mul_df(x,y));
 }
 
+/**
+ * Multiply-accumulate without saturation. Use a lfrac as accumulator.
+ *
+ * Performs z + x*y. See @ref lfrac for how many products can be accumulated.
+ *
+ * @param	x	Factor
+ * @param	y	Factor
+ * @param	z	Sumand / Accumulator
+ *
+ * @return		z + x*y
+ */
+FXP_DECLARATION(lfrac f_mac_lf(frac x, frac y, lfrac z))
+{
+	FXP_TM(f_mac_lf, FXP_TM_ADD_OVF(z.v, f_mul_df(x, y).v,
+					LFRAC_MIN_V, LFRAC_MAX_V));
+	z.v += f_mul_df(x, y).v;
+	return z;
+}
+
 /** @}
  * @}
  */
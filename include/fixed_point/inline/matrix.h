@@ -0,0 +1,233 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Matrix inline definitions
+ */
+
+#include "../matrix.h"
+#include "../vector.h"
+#include "../fixed_point.h"
+
+/**
+ * @addtogroup fxp_mat
+ * @{
+ */
+
+/**
+ * Transpose a single precision matrix.
+ */
+FXP_DECLARATION(mat3 m3_transpose(mat3 m))
+{
+	mat3 t;
+
+	t.x.x = m.x.x;	t.x.y = m.y.x;	t.x.z = m.z.x;
+	t.y.x = m.x.y;	t.y.y = m.y.y;	t.y.z = m.z.y;
+	t.z.x = m.x.z;	t.z.y = m.y.z;	t.z.z = m.z.z;
+
+	return t;
+}
+
+/**
+ * Transpose a double precision matrix.
+ */
+FXP_DECLARATION(dmat3 dm3_transpose(dmat3 m))
+{
+	dmat3 t;
+
+	t.x.x = m.x.x;	t.x.y = m.y.x;	t.x.z = m.z.x;
+	t.y.x = m.x.y;	t.y.y = m.y.y;	t.y.z = m.z.y;
+	t.z.x = m.x.z;	t.z.y = m.y.z;	t.z.z = m.z.z;
+
+	return t;
+}
+
+/**
+ * Convert a single precision matrix to double precision.
+ */
+FXP_DECLARATION(dmat3 m3_to_dm3(mat3 m))
+{
+	dmat3 r;
+
+	r.x = v_to_dv(m.x);
+	r.y = v_to_dv(m.y);
+	r.z = v_to_dv(m.z);
+
+	return r;
+}
+
+/**
+ * Convert a double precision matrix to single precision, by clipping and
+ * rounding to nearest.
+ *
+ * @see	dv_to_v_r
+ */
+FXP_DECLARATION(mat3 dm3_to_m3(dmat3 m))
+{
+	mat3 r;
+
+	r.x = dv_to_v_r(m.x);
+	r.y = dv_to_v_r(m.y);
+	r.z = dv_to_v_r(m.z);
+
+	return r;
+}
+
+/**
+ * Multiply a single precision matrix by a vector, yield double precision.
+ *
+ * Each component is computed with @ref v_dot_df, so it is exact unless it
+ * saturates.
+ */
+FXP_DECLARATION(dvec3 m3_mul_v_dv(mat3 m, vec3 v))
+{
+	dvec3 r;
+
+	r.x = v_dot_df(m.x, v);
+	r.y = v_dot_df(m.y, v);
+	r.z = v_dot_df(m.z, v);
+
+	return r;
+}
+
+/**
+ * Multiply a single precision matrix by a vector.
+ *
+ * The components are rounded to nearest once, from the result of
+ * @ref m3_mul_v_dv.
+ */
+FXP_DECLARATION(vec3 m3_mul_v(mat3 m, vec3 v))
+{
+	return dv_to_v_r(m3_mul_v_dv(m, v));
+}
+
+/**
+ * Multiply a double precision matrix by a single precision vector.
+ *
+ * The products are accumulated exactly (with 45 fractional bits) and each
+ * component is rounded to nearest and saturated once, so the result is
+ * within 0.5 LSB of the exact product. Discarding the bits below the 30th
+ * first does not change the rounding.
+ */
+FXP_DECLARATION(vec3 dm3_mul_v(dmat3 m, vec3 v))
+{
+	vec3 r;
+#define _DM3_ROW(e) do { \
+	lfrac_base s = (lfrac_base)m.e.x.v * v.x.v \
+		       + (lfrac_base)m.e.y.v * v.y.v \
+		       + (lfrac_base)m.e.z.v * v.z.v; \
+	lfrac t = {s >> FRAC_FBIT}; \
+	r.e = lf_to_f_r(t); \
+} while (0)
+
+	_DM3_ROW(x);
+	_DM3_ROW(y);
+	_DM3_ROW(z);
+
+#undef _DM3_ROW
+	return r;
+}
+
+/**
+ * Multiply two single precision matrices, yield double precision.
+ *
+ * Each element is computed with @ref v_dot_df, so it is exact unless it
+ * saturates.
+ */
+FXP_DECLARATION(dmat3 m3_mul_dm(mat3 a, mat3 b))
+{
+	mat3 bt = m3_transpose(b);
+	dmat3 r;
+
+	/* Row i of a*b is b' times row i of a */
+	r.x = m3_mul_v_dv(bt, a.x);
+	r.y = m3_mul_v_dv(bt, a.y);
+	r.z = m3_mul_v_dv(bt, a.z);
+
+	return r;
+}
+
+/**
+ * Multiply two single precision matrices.
+ *
+ * The elements are rounded to nearest once, from the result of
+ * @ref m3_mul_dm.
+ */
+FXP_DECLARATION(mat3 m3_mul(mat3 a, mat3 b))
+{
+	return dm3_to_m3(m3_mul_dm(a, b));
+}
+
+/**
+ * Rotation matrix of a quaternion, in double precision.
+ *
+ * The matrix is computed from the squares and products of the components
+ * of q with the homogeneous form, so that m3_mul_v(q_to_mat3(q), v) is the
+ * same rotation (and scaling by |q|**2) as @ref q_rot. The products are
+ * exact, so for a unit quaternion every element is exact.
+ */
+FXP_DECLARATION(dmat3 q_to_dmat3(quat q))
+{
+	dmat3 m;
+#define _QP(a, b) ((lfrac_base)f_mul_df(a, b).v)
+	lfrac_base rr = _QP(q.r, q.r), xx = _QP(q.v.x, q.v.x),
+		   yy = _QP(q.v.y, q.v.y), zz = _QP(q.v.z, q.v.z),
+		   xy = _QP(q.v.x, q.v.y), xz = _QP(q.v.x, q.v.z),
+		   yz = _QP(q.v.y, q.v.z), rx = _QP(q.r, q.v.x),
+		   ry = _QP(q.r, q.v.y), rz = _QP(q.r, q.v.z);
+#undef _QP
+#define _QM(e, value) do { lfrac t = {value}; m.e = lf_to_df(t); } while (0)
+
+	_QM(x.x, rr + xx - yy - zz);
+	_QM(x.y, 2 * (xy - rz));
+	_QM(x.z, 2 * (xz + ry));
+	_QM(y.x, 2 * (xy + rz));
+	_QM(y.y, rr - xx + yy - zz);
+	_QM(y.z, 2 * (yz - rx));
+	_QM(z.x, 2 * (xz - ry));
+	_QM(z.y, 2 * (yz + rx));
+	_QM(z.z, rr - xx - yy + zz);
+
+#undef _QM
+	return m;
+}
+
+/**
+ * Rotation matrix of a quaternion.
+ *
+ * Each element of @ref q_to_dmat3 is rounded to nearest once.
+ */
+FXP_DECLARATION(mat3 q_to_mat3(quat q))
+{
+	return dm3_to_m3(q_to_dmat3(q));
+}
+
+/** @}
+ */
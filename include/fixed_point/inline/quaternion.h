@@ -264,6 +264,8 @@ FXP_DECLARATION(vec3 q_rot(quat q, vec3 v))
  * This function attempts to bring the norm of the quaternion closer to 1.
  * It only works for quaternions whose norm is already close to 1. It uses and
  * approximation for the norm (q_xnormerror).
+ *
+ * @ref q_normalize is exact and works for any norm.
  */
 FXP_DECLARATION(quat q_xrenorm(quat q))
 {
@@ -278,7 +280,7 @@ FXP_DECLARATION(quat q_xrenorm(quat q))
 /**
  * Renormalize quaternion.
  *
- * See @ref q_xrenorm.
+ * See @ref q_xrenorm and @ref dq_normalize.
  */
 FXP_DECLARATION(dquat dq_xrenorm(dquat q))
 {
@@ -114,6 +114,21 @@ MAKE_VEC_SCALAR_F(dv_idiv, dvec3, int16_t, df_idiv)
  */
 MAKE_VEC_SCALAR_F(ev_idiv, evec3, int16_t, ef_idiv)
 
+/**
+ * Divide vector by a precomputed integer divider.
+ */
+MAKE_VEC_SCALAR_F(v_idivd, vec3, const idivider *, f_idivd)
+
+/**
+ * Divide double precision vector by a precomputed integer divider.
+ */
+MAKE_VEC_SCALAR_F(dv_idivd, dvec3, const idivider *, df_idivd)
+
+/**
+ * Divide extended precision vector by a precomputed integer divider.
+ */
+MAKE_VEC_SCALAR_F(ev_idivd, evec3, const idivider *, ef_idivd)
+
 /**
  * Arithmetic shift components left.
  */
@@ -177,6 +192,80 @@ MAKE_VEC_ELEM_F(v_to_dv, dvec3, vec3, f_to_df)
  */
 MAKE_VEC_ELEM_F(dv_to_v, vec3, dvec3, df_to_f)
 
+/**
+ * Convert double precision vector to single precision, by clipping and
+ * rounding to nearest.
+ *
+ * @see	df_to_f_r
+ */
+MAKE_VEC_ELEM_F(dv_to_v_r, vec3, dvec3, df_to_f_r)
+
+/**
+ * Convert double precision vector to single precision, by clipping and
+ * performing convergent rounding.
+ *
+ * @see	df_to_f_cr
+ */
+MAKE_VEC_ELEM_F(dv_to_v_cr, vec3, dvec3, df_to_f_cr)
+
+/**
+ * Dot product of single precision vectors, yield double precision.
+ *
+ * The products are accumulated exactly and the sum is saturated once, which
+ * only happens when it reaches 2 or -2.
+ */
+FXP_DECLARATION(dfrac v_dot_df(vec3 a, vec3 b))
+{
+	lfrac acc = {0};
+
+	acc = f_mac_lf(a.x, b.x, acc);
+	acc = f_mac_lf(a.y, b.y, acc);
+	acc = f_mac_lf(a.z, b.z, acc);
+
+	return lf_to_df(acc);
+}
+
+/**
+ * Squared norm of a single precision vector, yield double precision.
+ *
+ * Saturates if the norm is sqrt(2) or more.
+ */
+FXP_DECLARATION(dfrac v_norm2_df(vec3 a))
+{
+	return v_dot_df(a, a);
+}
+
+/**
+ * Cross product of single precision vectors, yield double precision.
+ *
+ * Each component is exact: the largest difference of two products is
+ * (-1)*(-1) - (-1)*(1 - 2**-15), which fits in a dfrac. The saturating
+ * subtraction is only defensive.
+ */
+FXP_DECLARATION(dvec3 v_cross_dv(vec3 a, vec3 b))
+{
+	dvec3 r;
+
+	r.x = df_subsat(f_mul_df(a.y, b.z), f_mul_df(a.z, b.y));
+	r.y = df_subsat(f_mul_df(a.z, b.x), f_mul_df(a.x, b.z));
+	r.z = df_subsat(f_mul_df(a.x, b.y), f_mul_df(a.y, b.x));
+
+	return r;
+}
+
+/**
+ * Cross product of single precision vectors.
+ *
+ * The components are computed in double precision and then rounded to
+ * nearest and saturated.
+ *
+ * @see	v_cross_dv
+ */
+FXP_DECLARATION(vec3 v_cross(vec3 a, vec3 b))
+{
+	return dv_to_v_r(v_cross_dv(a, b));
+}
+
 
 /** @}
  */
@@ -0,0 +1,81 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Type definitions for 3x3 matrices.
+ */
+
+#ifndef FIXED_POINT_MATRIX_T_H
+#define FIXED_POINT_MATRIX_T_H
+
+#include "types.h"
+#include "vector_types.h"
+
+/**
+ * @defgroup fxp_mat	Matrices
+ * @{
+ *
+ * Matrices are stored by rows, so the product with a column vector is the dot
+ * product of each row with the vector.
+ */
+
+/**
+ * Single precision 3x3 matrix.
+ *
+ * Elements are represented by values of type @ref frac .
+ */
+typedef struct {
+	vec3 x,y,z;	/*!< Rows */
+} mat3;
+
+/**
+ * Double precision 3x3 matrix.
+ *
+ * Elements are represented by values of type @ref dfrac .
+ */
+typedef struct {
+	dvec3 x,y,z;	/*!< Rows */
+} dmat3;
+
+/** Literal for the zero matrix */
+#define MAT0 {VEC0, VEC0, VEC0}
+
+/** Literal for the identity matrix (single precision, 1 is FRAC_1_V) */
+#define MAT3_I {{{FRAC_1_V},{0},{0}}, {{0},{FRAC_1_V},{0}}, \
+		{{0},{0},{FRAC_1_V}}}
+
+/** Literal for the double precision identity matrix */
+#define DMAT3_I {{{DFRAC_1_V},{0},{0}}, {{0},{DFRAC_1_V},{0}}, \
+		 {{0},{0},{DFRAC_1_V}}}
+
+/** @}
+ */
+
+#endif /* FIXED_POINT_MATRIX_T_H */
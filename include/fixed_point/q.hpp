@@ -0,0 +1,410 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Generic Q format numbers for C++.
+ *
+ * This header is independent of the C library: it only uses the type
+ * definitions in types.h, and everything is defined inline. It requires
+ * C++14.
+ */
+
+#ifndef FXP_Q_HPP
+#define FXP_Q_HPP
+
+#if __cplusplus < 201402L
+#error "fixed_point/q.hpp requires C++14"
+#endif
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "types.h"
+
+/**
+ * @defgroup fxp_cpp	C++ Q format template
+ * @{
+ *
+ * Q<I, F, T> is a signed number with I integer bits (including the sign) and F
+ * fractional bits, stored in the integer type T. By default T is the smallest
+ * type that fits I + F bits.
+ *
+ * Addition, subtraction, multiplication and division yield a format that is
+ * computed at compile time:
+ *
+ * | Operation | Result format                      |
+ * |-----------|------------------------------------|
+ * | a +- b    | Q<max(Ia, Ib) + 1, max(Fa, Fb)>    |
+ * | a * b     | Q<Ia + Ib, Fa + Fb>                |
+ * | a / b     | Q<Ia + Fb + 1, Fa + Ib - 1>        |
+ * | -a        | Q<Ia + 1, Fa>                      |
+ *
+ * Addition, subtraction, negation and multiplication are exact. Division
+ * truncates towards zero (as the integer division does) and saturates when
+ * dividing by zero. For example, Q1.15 * Q1.15 gives Q2.30 (a frac times a
+ * frac is a dfrac) and Q1.15 / Q1.15 gives Q17.15 (an efrac). Formats wider
+ * than 64 bits are rejected at compile time.
+ *
+ * To go back to a narrower format, use @ref fxp::q_cast (floor) or
+ * @ref fxp::q_round (round half up), which saturate.
+ *
+ * Like the C types, Q is an aggregate with a single member v, so it is
+ * initialized with the raw value, eg. `frac_t{FRAC_0_5_V}`. The predefined
+ * formats are layout compatible with their C counterparts, and arrays can be
+ * passed to the C routines with a cast.
+ *
+ * Everything is constexpr.
+ */
+
+namespace fxp {
+
+namespace detail {
+
+/* Smallest signed integer type with at least N bits */
+template <int N>
+struct storage {
+	static_assert(N > 0 && N <= 64, "Q formats are limited to 64 bits");
+
+	using type = typename std::conditional<(N <= 8), std::int8_t,
+		typename std::conditional<(N <= 16), std::int16_t,
+		typename std::conditional<(N <= 32), std::int32_t,
+			std::int64_t>::type>::type>::type;
+};
+
+constexpr int max(int a, int b)
+{
+	return (a > b)? a : b;
+}
+
+constexpr double pow2(int n)
+{
+	return (n >= 0)? (double)((std::uint64_t)1 << n)
+		       : 1.0 / (double)((std::uint64_t)1 << -n);
+}
+
+/* x * 2**s, for s >= 0. Unlike a shift, this is defined for negative x. */
+template <typename W, typename T>
+constexpr W scale(T x, int s)
+{
+	return (W)x * ((W)1 << s);
+}
+
+} /* namespace detail */
+
+/**
+ * Fixed point number in Q(I).(F) format.
+ *
+ * @tparam	I	Integer bits, including the sign.
+ * @tparam	F	Fractional bits.
+ * @tparam	T	Signed integer type used for storage.
+ */
+template <int I, int F, typename T = typename detail::storage<I + F>::type>
+struct Q {
+	static_assert(std::is_integral<T>::value && std::is_signed<T>::value,
+		      "the storage must be a signed integer");
+	static_assert(I >= 1 && F >= 0, "invalid format");
+	static_assert(I + F <= std::numeric_limits<T>::digits + 1,
+		      "the format does not fit in the storage type");
+
+	using storage = T;			/*!< Storage type */
+	static constexpr int int_bits = I;	/*!< Integer bits */
+	static constexpr int frac_bits = F;	/*!< Fractional bits */
+	static constexpr int bits = I + F;	/*!< Significant bits */
+
+	/** Largest raw value */
+	static constexpr T raw_max = (T)(((std::uint64_t)1 << (bits - 1)) - 1);
+	/** Smallest raw value */
+	static constexpr T raw_min = (T)(-raw_max - 1);
+
+	T v;	/*!< Raw value */
+
+	/** Make a number from its raw value. */
+	static constexpr Q from_raw(T x)
+	{
+		return Q{x};
+	}
+
+	/** Largest representable number. */
+	static constexpr Q max()
+	{
+		return Q{raw_max};
+	}
+
+	/** Smallest (most negative) representable number. */
+	static constexpr Q min()
+	{
+		return Q{raw_min};
+	}
+
+	/**
+	 * Convert from floating point, rounding half away from zero and
+	 * saturating. NaN is converted to zero.
+	 */
+	static constexpr Q from_double(double x)
+	{
+		double y = x * detail::pow2(F);
+
+		if (!(y == y))
+			return Q{0};
+		if (y >= (double)raw_max)
+			return Q{raw_max};
+		if (y <= (double)raw_min)
+			return Q{raw_min};
+
+		return Q{(T)(y + ((y < 0)? -0.5 : 0.5))};
+	}
+
+	/** Convert to floating point. */
+	constexpr double to_double() const
+	{
+		return (double)v * detail::pow2(-F);
+	}
+};
+
+template <int I, int F, typename T>
+constexpr T Q<I, F, T>::raw_max;
+
+template <int I, int F, typename T>
+constexpr T Q<I, F, T>::raw_min;
+
+/** @name Result formats
+ * @{
+ */
+
+template <typename A, typename B>
+using sum_t = Q<detail::max(A::int_bits, B::int_bits) + 1,
+		detail::max(A::frac_bits, B::frac_bits)>;
+
+template <typename A, typename B>
+using product_t = Q<A::int_bits + B::int_bits, A::frac_bits + B::frac_bits>;
+
+template <typename A, typename B>
+using quotient_t = Q<A::int_bits + B::frac_bits + 1,
+		     A::frac_bits + B::int_bits - 1>;
+
+template <typename A>
+using neg_t = Q<A::int_bits + 1, A::frac_bits>;
+
+/** @}
+ */
+
+/** @name Predefined formats, layout compatible with the C types
+ * @{
+ */
+
+using mfrac_t = Q<MFRAC_IBIT, MFRAC_FBIT, mfrac_base>;
+using frac_t = Q<FRAC_IBIT, FRAC_FBIT, frac_base>;
+using dfrac_t = Q<DFRAC_IBIT, DFRAC_FBIT, dfrac_base>;
+using efrac_t = Q<EFRAC_IBIT, EFRAC_FBIT, efrac_base>;
+using lfrac_t = Q<LFRAC_IBIT, LFRAC_FBIT, lfrac_base>;
+
+/** @}
+ */
+
+#define FXP_Q_LAYOUT_CHECK(q, c) \
+	static_assert(sizeof(q) == sizeof(c) && alignof(q) == alignof(c) \
+		      && std::is_standard_layout<q>::value \
+		      && std::is_trivial<q>::value, \
+		      #q " is not layout compatible with " #c)
+
+FXP_Q_LAYOUT_CHECK(mfrac_t, mfrac);
+FXP_Q_LAYOUT_CHECK(frac_t, frac);
+FXP_Q_LAYOUT_CHECK(dfrac_t, dfrac);
+FXP_Q_LAYOUT_CHECK(efrac_t, efrac);
+FXP_Q_LAYOUT_CHECK(lfrac_t, lfrac);
+
+#undef FXP_Q_LAYOUT_CHECK
+
+/** @name Conversion from and to the C types
+ * @{
+ */
+
+constexpr mfrac_t from_c(mfrac x) { return mfrac_t{x.v}; }
+constexpr frac_t from_c(frac x) { return frac_t{x.v}; }
+constexpr dfrac_t from_c(dfrac x) { return dfrac_t{x.v}; }
+constexpr efrac_t from_c(efrac x) { return efrac_t{x.v}; }
+constexpr lfrac_t from_c(lfrac x) { return lfrac_t{x.v}; }
+
+constexpr mfrac to_c(mfrac_t x) { return mfrac{x.v}; }
+constexpr frac to_c(frac_t x) { return frac{x.v}; }
+constexpr dfrac to_c(dfrac_t x) { return dfrac{x.v}; }
+constexpr efrac to_c(efrac_t x) { return efrac{x.v}; }
+constexpr lfrac to_c(lfrac_t x) { return lfrac{x.v}; }
+
+/** @}
+ */
+
+/** @name Arithmetic
+ * @{
+ */
+
+template <int Ia, int Fa, typename Ta, int Ib, int Fb, typename Tb>
+constexpr sum_t<Q<Ia, Fa, Ta>, Q<Ib, Fb, Tb>>
+operator+(Q<Ia, Fa, Ta> a, Q<Ib, Fb, Tb> b)
+{
+	using R = sum_t<Q<Ia, Fa, Ta>, Q<Ib, Fb, Tb>>;
+	using W = typename R::storage;
+
+	return R{(W)(detail::scale<W>(a.v, R::frac_bits - Fa)
+		     + detail::scale<W>(b.v, R::frac_bits - Fb))};
+}
+
+template <int Ia, int Fa, typename Ta, int Ib, int Fb, typename Tb>
+constexpr sum_t<Q<Ia, Fa, Ta>, Q<Ib, Fb, Tb>>
+operator-(Q<Ia, Fa, Ta> a, Q<Ib, Fb, Tb> b)
+{
+	using R = sum_t<Q<Ia, Fa, Ta>, Q<Ib, Fb, Tb>>;
+	using W = typename R::storage;
+
+	return R{(W)(detail::scale<W>(a.v, R::frac_bits - Fa)
+		     - detail::scale<W>(b.v, R::frac_bits - Fb))};
+}
+
+template <int I, int F, typename T>
+constexpr neg_t<Q<I, F, T>> operator-(Q<I, F, T> a)
+{
+	using R = neg_t<Q<I, F, T>>;
+	using W = typename R::storage;
+
+	return R{(W)-(W)a.v};
+}
+
+template <int Ia, int Fa, typename Ta, int Ib, int Fb, typename Tb>
+constexpr product_t<Q<Ia, Fa, Ta>, Q<Ib, Fb, Tb>>
+operator*(Q<Ia, Fa, Ta> a, Q<Ib, Fb, Tb> b)
+{
+	using R = product_t<Q<Ia, Fa, Ta>, Q<Ib, Fb, Tb>>;
+	using W = typename R::storage;
+
+	return R{(W)((W)a.v * (W)b.v)};
+}
+
+template <int Ia, int Fa, typename Ta, int Ib, int Fb, typename Tb>
+constexpr quotient_t<Q<Ia, Fa, Ta>, Q<Ib, Fb, Tb>>
+operator/(Q<Ia, Fa, Ta> a, Q<Ib, Fb, Tb> b)
+{
+	using R = quotient_t<Q<Ia, Fa, Ta>, Q<Ib, Fb, Tb>>;
+	using W = typename R::storage;
+
+	if (b.v == 0)
+		return (a.v < 0)? R::min() : R::max();
+
+	return R{(W)(detail::scale<W>(a.v, Ib + Fb - 1) / (W)b.v)};
+}
+
+/** @}
+ */
+
+/** @name Comparison
+ * @{
+ */
+
+#define FXP_Q_COMPARISON(op) \
+template <int Ia, int Fa, typename Ta, int Ib, int Fb, typename Tb> \
+constexpr bool operator op(Q<Ia, Fa, Ta> a, Q<Ib, Fb, Tb> b) \
+{ \
+	using W = typename sum_t<Q<Ia, Fa, Ta>, Q<Ib, Fb, Tb>>::storage; \
+	constexpr int f = detail::max(Fa, Fb); \
+	return detail::scale<W>(a.v, f - Fa) op detail::scale<W>(b.v, f - Fb); \
+}
+
+FXP_Q_COMPARISON(==)
+FXP_Q_COMPARISON(!=)
+FXP_Q_COMPARISON(<)
+FXP_Q_COMPARISON(<=)
+FXP_Q_COMPARISON(>)
+FXP_Q_COMPARISON(>=)
+
+#undef FXP_Q_COMPARISON
+
+/** @}
+ */
+
+/** @name Format conversion
+ * @{
+ */
+
+/**
+ * Convert to another format, rounding towards minus infinity and saturating.
+ */
+template <typename R, int I, int F, typename T>
+constexpr R q_cast(Q<I, F, T> x)
+{
+	using W = typename R::storage;
+	constexpr int s = R::frac_bits - F;
+	/* Shift amounts for each direction, so that the branch not taken is
+	 * still valid */
+	constexpr int sl = (s > 0)? s : 0, sr = (s < 0)? -s : 0;
+	std::int64_t y = x.v;
+
+	if (s >= 0) {
+		if (y > (std::int64_t)(R::raw_max >> sl))
+			return R::max();
+		if (y < (std::int64_t)(R::raw_min >> sl))
+			return R::min();
+		return R{detail::scale<W>(y, sl)};
+	}
+
+	y >>= sr;
+	return (y > R::raw_max)? R::max()
+		: ((y < R::raw_min)? R::min() : R{(W)y});
+}
+
+/**
+ * Convert to another format, rounding to nearest (ties up) and saturating.
+ */
+template <typename R, int I, int F, typename T>
+constexpr R q_round(Q<I, F, T> x)
+{
+	using W = typename R::storage;
+	constexpr int s = R::frac_bits - F;
+	constexpr int sr = (s < 0)? -s : 1;
+	std::int64_t y = x.v;
+
+	if (s >= 0)
+		return q_cast<R>(x);
+
+	/* Adding the first discarded bit after the shift cannot overflow, even
+	 * for a 64 bit y. */
+	y = (y >> sr) + ((y >> (sr - 1)) & 1);
+	return (y > R::raw_max)? R::max()
+		: ((y < R::raw_min)? R::min() : R{(W)y});
+}
+
+/** @}
+ */
+
+} /* namespace fxp */
+
+/** @}
+ */
+
+#endif /* FXP_Q_HPP */
@@ -37,9 +37,64 @@
 #ifndef FIXED_POINT_QUATERNION_H
 #define FIXED_POINT_QUATERNION_H
 
+#include <stddef.h>
 #include "common.h"
 #include "quaternion_types.h"
 
+/**
+ * @addtogroup fxp_quat
+ * @{
+ */
+
+/**
+ * Normalize quaternion (single precision).
+ *
+ * Unlike @ref q_xrenorm, this works for any norm. The sum of squares is
+ * computed exactly, its reciprocal square root is obtained with
+ * @ref df_rsqrt and each component is rounded once. Each component is the
+ * exact value rounded to nearest, except when that value is within about
+ * 2**-16 LSB of a tie, and for components that saturate at 1.
+ *
+ * A null quaternion is returned unchanged.
+ */
+quat q_normalize(quat q);
+
+/**
+ * Normalize quaternion (double precision).
+ *
+ * See @ref q_normalize. The reciprocal of the norm has the same resolution as
+ * the components, so here the error can reach 2 LSB.
+ */
+dquat dq_normalize(dquat q);
+
+/** Array version of @ref q_normalize. */
+void q_normalize_n(quat *dst, const quat *q, size_t n);
+
+/** Array version of @ref dq_normalize. */
+void dq_normalize_n(dquat *dst, const dquat *q, size_t n);
+
+/**
+ * Rotate n vectors by the same quaternion.
+ *
+ * The rotation matrix is computed once with @ref q_to_mat3 and every vector is
+ * multiplied by it as in @ref m3_mul_v, which takes 9 multiplications instead
+ * of the 32 of @ref q_rot. The matrix elements are within 0.5 LSB of their
+ * exact values and the products are rounded once, so for a unit quaternion
+ * the results are within 2 LSB of the exact rotation of v[i] by q.
+ *
+ * @ref q_rot rounds after every product and is less accurate. For random
+ * unit quaternions and vectors of norm up to 1, tests/quaternion.c measures
+ * errors of up to 1.3 LSB for this function and 5.3 LSB for @ref q_rot,
+ * and checks them against bounds of 2 and 6 LSB.
+ *
+ * The output may be the same as the input, but they must not overlap
+ * partially.
+ */
+void q_rot_n(vec3 *dst, quat q, const vec3 *v, size_t n);
+
+/** @}
+ */
+
 #ifdef FXP_C99_INLINE
 
 #ifndef _FXP_INLINE_KW
@@ -0,0 +1,287 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Structure-of-arrays containers for 3D vectors.
+ */
+
+#ifndef FXP_SOA_H
+#define FXP_SOA_H
+
+#include <stddef.h>
+#include "types.h"
+#include "vector_types.h"
+#include "quaternion_types.h"
+#include "fixed_point.h"
+
+/**
+ * @addtogroup fxp_vec
+ * @{
+ *
+ * @defgroup fxp_soa	Structure-of-arrays vectors
+ * @{
+ *
+ * A vec3 array stores the components of each vector next to each other. The
+ * containers defined here store instead each component of all the vectors in
+ * its own array (plane), so that batches of vectors can be processed with the
+ * vectorized array routines.
+ *
+ * Each function in this group applies the vector function of the same name
+ * (without the _soa suffix) to n vectors and gives exactly the same results.
+ * The containers only hold pointers to the planes, so the same rules as for
+ * the array routines apply: the output may be the same as one of the inputs,
+ * but the planes must not overlap partially. Offsetting the pointers gives a
+ * view of a range of vectors.
+ *
+ * Packed arrays of vectors and quaternions are converted to and from the
+ * containers with the *_to_soa and *_from_soa functions. They work on any
+ * range, so a long stream can be converted in chunks that fit in the cache,
+ * processed, and converted back before moving on to the next chunk.
+ */
+
+/** Alignment of the planes set up by the *_soa_init functions, in bytes. */
+#define FXP_SOA_ALIGN 64
+
+/**
+ * Elements of type t in each plane of n vectors, rounded up to keep every
+ * plane aligned.
+ */
+#define FXP_SOA_STRIDE(t, n) \
+	(((n) + FXP_SOA_ALIGN/sizeof(t) - 1) / (FXP_SOA_ALIGN/sizeof(t)) \
+	 * (FXP_SOA_ALIGN/sizeof(t)))
+
+/**
+ * Elements of type t needed for the buffer of n vectors.
+ *
+ * The buffer does not need to be aligned: this includes room for moving the
+ * first plane to an aligned address.
+ */
+#define FXP_SOA_LEN(t, n) (3 * FXP_SOA_STRIDE(t, n) + FXP_SOA_ALIGN/sizeof(t))
+
+/** Same as @ref FXP_SOA_LEN, for n quaternions. */
+#define FXP_SOA_QLEN(t, n) (4 * FXP_SOA_STRIDE(t, n) + FXP_SOA_ALIGN/sizeof(t))
+
+/** Structure-of-arrays version of @ref mvec3. */
+typedef struct {
+	mfrac *x, *y, *z;
+} mvec3_soa;
+
+/** Structure-of-arrays version of @ref vec3. */
+typedef struct {
+	frac *x, *y, *z;
+} vec3_soa;
+
+/** Structure-of-arrays version of @ref dvec3. */
+typedef struct {
+	dfrac *x, *y, *z;
+} dvec3_soa;
+
+/** Structure-of-arrays version of @ref evec3. */
+typedef struct {
+	efrac *x, *y, *z;
+} evec3_soa;
+
+/** Structure-of-arrays version of @ref quat. */
+typedef struct {
+	frac *r, *x, *y, *z;
+} quat_soa;
+
+/** Structure-of-arrays version of @ref dquat. */
+typedef struct {
+	dfrac *r, *x, *y, *z;
+} dquat_soa;
+
+/**
+ * Set up the planes of a container in a buffer.
+ *
+ * @param	v	Container.
+ * @param	buf	Buffer of FXP_SOA_LEN(mfrac, n) elements.
+ * @param	n	Maximum number of vectors.
+ */
+void mvec3_soa_init(mvec3_soa *v, mfrac *buf, size_t n);
+
+/** Set up the planes of a container. See @ref mvec3_soa_init. */
+void vec3_soa_init(vec3_soa *v, frac *buf, size_t n);
+
+/** Set up the planes of a container. See @ref mvec3_soa_init. */
+void dvec3_soa_init(dvec3_soa *v, dfrac *buf, size_t n);
+
+/** Set up the planes of a container. See @ref mvec3_soa_init. */
+void evec3_soa_init(evec3_soa *v, efrac *buf, size_t n);
+
+/**
+ * Set up the planes of a container in a buffer.
+ *
+ * @param	q	Container.
+ * @param	buf	Buffer of FXP_SOA_QLEN(frac, n) elements.
+ * @param	n	Maximum number of quaternions.
+ */
+void quat_soa_init(quat_soa *q, frac *buf, size_t n);
+
+/** Set up the planes of a container. See @ref quat_soa_init. */
+void dquat_soa_init(dquat_soa *q, dfrac *buf, size_t n);
+
+/** Split n packed vectors into their components. */
+void mv_to_soa(mvec3_soa dst, const mvec3 *src, size_t n);
+
+/** Pack the components of n vectors. */
+void mv_from_soa(mvec3 *dst, mvec3_soa src, size_t n);
+
+/** Split n packed vectors into their components. */
+void v_to_soa(vec3_soa dst, const vec3 *src, size_t n);
+
+/** Pack the components of n vectors. */
+void v_from_soa(vec3 *dst, vec3_soa src, size_t n);
+
+/** Split n packed vectors into their components. */
+void dv_to_soa(dvec3_soa dst, const dvec3 *src, size_t n);
+
+/** Pack the components of n vectors. */
+void dv_from_soa(dvec3 *dst, dvec3_soa src, size_t n);
+
+/** Split n packed vectors into their components. */
+void ev_to_soa(evec3_soa dst, const evec3 *src, size_t n);
+
+/** Pack the components of n vectors. */
+void ev_from_soa(evec3 *dst, evec3_soa src, size_t n);
+
+/** Split n packed quaternions into their components. */
+void q_to_soa(quat_soa dst, const quat *src, size_t n);
+
+/** Pack the components of n quaternions. */
+void q_from_soa(quat *dst, quat_soa src, size_t n);
+
+/** Split n packed quaternions into their components. */
+void dq_to_soa(dquat_soa dst, const dquat *src, size_t n);
+
+/** Pack the components of n quaternions. */
+void dq_from_soa(dquat *dst, dquat_soa src, size_t n);
+
+/** Structure-of-arrays version of @ref q_rot_n. */
+void q_rot_soa(vec3_soa dst, quat q, vec3_soa v, size_t n);
+
+/** Batch version of @ref v_add. */
+void v_add_soa(vec3_soa dst, vec3_soa a, vec3_soa b, size_t n);
+
+/** Batch version of @ref v_sub. */
+void v_sub_soa(vec3_soa dst, vec3_soa a, vec3_soa b, size_t n);
+
+/** Batch version of @ref ev_add. */
+void ev_add_soa(evec3_soa dst, evec3_soa a, evec3_soa b, size_t n);
+
+/** Batch version of @ref ev_sub. */
+void ev_sub_soa(evec3_soa dst, evec3_soa a, evec3_soa b, size_t n);
+
+/** Batch version of @ref dv_add. */
+void dv_add_soa(dvec3_soa dst, dvec3_soa a, dvec3_soa b, size_t n);
+
+/** Batch version of @ref dv_addsat. */
+void dv_addsat_soa(dvec3_soa dst, dvec3_soa a, dvec3_soa b, size_t n);
+
+/** Batch version of @ref dv_sub. */
+void dv_sub_soa(dvec3_soa dst, dvec3_soa a, dvec3_soa b, size_t n);
+
+/** Batch version of @ref v_mvmul_ev. */
+void v_mvmul_ev_soa(evec3_soa dst, vec3_soa a, mvec3_soa b, size_t n);
+
+/** Multiply every vector by the same integer. See @ref v_imul. */
+void v_imul_soa(vec3_soa dst, vec3_soa a, int16_t b, size_t n);
+
+/** Multiply every vector by the same integer. See @ref dv_imul. */
+void dv_imul_soa(dvec3_soa dst, dvec3_soa a, int16_t b, size_t n);
+
+/** Multiply every vector by the same integer. See @ref ev_imul. */
+void ev_imul_soa(evec3_soa dst, evec3_soa a, int b, size_t n);
+
+/** Divide every vector by the same integer. See @ref v_idiv. */
+void v_idiv_soa(vec3_soa dst, vec3_soa a, int16_t b, size_t n);
+
+/** Divide every vector by the same integer. See @ref dv_idiv. */
+void dv_idiv_soa(dvec3_soa dst, dvec3_soa a, int16_t b, size_t n);
+
+/** Divide every vector by the same integer. See @ref ev_idiv. */
+void ev_idiv_soa(evec3_soa dst, evec3_soa a, int16_t b, size_t n);
+
+/** Divide every vector by a precomputed divider. See @ref v_idivd. */
+void v_idivd_soa(vec3_soa dst, vec3_soa a, const idivider *d, size_t n);
+
+/** Divide every vector by a precomputed divider. See @ref dv_idivd. */
+void dv_idivd_soa(dvec3_soa dst, dvec3_soa a, const idivider *d, size_t n);
+
+/** Divide every vector by a precomputed divider. See @ref ev_idivd. */
+void ev_idivd_soa(evec3_soa dst, evec3_soa a, const idivider *d, size_t n);
+
+/** Shift every vector left by the same amount. See @ref dv_shiftl. */
+void dv_shiftl_soa(dvec3_soa dst, dvec3_soa a, int8_t b, size_t n);
+
+/** Shift every vector right by the same amount. See @ref dv_shiftr. */
+void dv_shiftr_soa(dvec3_soa dst, dvec3_soa a, int8_t b, size_t n);
+
+/** Clip every vector to the same limit. See @ref v_clip. */
+void v_clip_soa(vec3_soa dst, vec3_soa a, frac b, size_t n);
+
+/** Multiply every vector by the same integer. See @ref v_imul_ev. */
+void v_imul_ev_soa(evec3_soa dst, vec3_soa a, int b, size_t n);
+
+/** Divide every vector by the same efrac. See @ref v_efdiv_ev. */
+void v_efdiv_ev_soa(evec3_soa dst, vec3_soa a, efrac b, size_t n);
+
+/** Multiply every vector by the same frac. See @ref v_fmul. */
+void v_fmul_soa(vec3_soa dst, vec3_soa a, frac b, size_t n);
+
+/** Multiply every vector by the same frac. See @ref v_fmul_dv. */
+void v_fmul_dv_soa(dvec3_soa dst, vec3_soa a, frac b, size_t n);
+
+/** Multiply every vector by the same mfrac. See @ref v_mfmul_ev. */
+void v_mfmul_ev_soa(evec3_soa dst, vec3_soa a, mfrac b, size_t n);
+
+/** Batch version of @ref ev_to_v. */
+void ev_to_v_soa(vec3_soa dst, evec3_soa a, size_t n);
+
+/** Batch version of @ref v_to_ev. */
+void v_to_ev_soa(evec3_soa dst, vec3_soa a, size_t n);
+
+/** Batch version of @ref v_to_dv. */
+void v_to_dv_soa(dvec3_soa dst, vec3_soa a, size_t n);
+
+/** Batch version of @ref dv_to_v. */
+void dv_to_v_soa(vec3_soa dst, dvec3_soa a, size_t n);
+
+/** Batch version of @ref dv_to_v_r. */
+void dv_to_v_r_soa(vec3_soa dst, dvec3_soa a, size_t n);
+
+/** Batch version of @ref dv_to_v_cr. */
+void dv_to_v_cr_soa(vec3_soa dst, dvec3_soa a, size_t n);
+
+/** @}
+ * @}
+ */
+
+#endif /* FXP_SOA_H */
@@ -0,0 +1,115 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Square roots and reciprocal square roots.
+ */
+
+#ifndef FXP_SQRT_H
+#define FXP_SQRT_H
+
+#include <stddef.h>
+#include "types.h"
+#include "vector_types.h"
+
+/**
+ * @defgroup fxp_sqrt	Square root
+ * @{
+ *
+ * Square roots computed with multiplications only.
+ *
+ * The reciprocal square root of the normalized argument is looked up in a
+ * table of 192 entries (384 bytes) and refined with Newton-Raphson iterations
+ * (one for 16 bit results, two for 32 bit ones). The square root is obtained
+ * by multiplying by the argument, and a final correction step makes it
+ * exact.
+ *
+ * The square root of a negative number is 0.
+ */
+
+/**
+ * Square root of a fractional.
+ *
+ * @return	sqrt(x), rounded to nearest.
+ */
+frac f_sqrt(frac x);
+
+/**
+ * Square root of a double precision fractional.
+ *
+ * @return	sqrt(x), rounded to nearest.
+ */
+dfrac df_sqrt(dfrac x);
+
+/**
+ * Square root of an extended precision fractional.
+ *
+ * @return	sqrt(x), rounded to nearest.
+ */
+efrac ef_sqrt(efrac x);
+
+/**
+ * Reciprocal square root of a double precision fractional.
+ *
+ * The result saturates for x <= 0.25, including zero and negative numbers.
+ *
+ * @return	1/sqrt(x), rounded to nearest and saturated.
+ */
+dfrac df_rsqrt(dfrac x);
+
+/**
+ * Euclidean norm of a single precision vector.
+ *
+ * The sum of squares is exact, so the result is rounded only once. It
+ * saturates if the norm is 1 or more.
+ *
+ * @return	|a|, rounded to nearest and saturated.
+ */
+frac v_norm(vec3 a);
+
+/** Array version of @ref f_sqrt. */
+void f_sqrt_n(frac *dst, const frac *x, size_t n);
+
+/** Array version of @ref df_sqrt. */
+void df_sqrt_n(dfrac *dst, const dfrac *x, size_t n);
+
+/** Array version of @ref ef_sqrt. */
+void ef_sqrt_n(efrac *dst, const efrac *x, size_t n);
+
+/** Array version of @ref df_rsqrt. */
+void df_rsqrt_n(dfrac *dst, const dfrac *x, size_t n);
+
+/** Array version of @ref v_norm. */
+void v_norm_n(frac *dst, const vec3 *a, size_t n);
+
+/** @}
+ */
+
+#endif /* FXP_SQRT_H */
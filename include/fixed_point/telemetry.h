@@ -0,0 +1,212 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Saturation and overflow telemetry.
+ */
+
+#ifndef FXP_TELEMETRY_H
+#define FXP_TELEMETRY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @defgroup fxp_telemetry	Telemetry
+ * @{
+ *
+ * When the library and the code using it are compiled with FXP_TELEMETRY
+ * defined (`make TELEMETRY=1` for the library), every operation that can wrap
+ * around, saturate or clip counts how many times it was called and how many
+ * of those calls produced such an event. This shows which operations waste
+ * dynamic range or lose it, and by how much, on real data.
+ *
+ * The counters are thread-local: each thread sees only its own operations.
+ * Telemetry builds do not use the vectorized kernels, so that array functions
+ * are counted element by element through the scalar operations.
+ *
+ * Operations built on top of others also update the counters of those. For
+ * example, a saturation in f_addsat is counted for f_addsat and for ef_to_f,
+ * and vector and quaternion functions are only counted through the scalar
+ * operations they use.
+ *
+ * Without FXP_TELEMETRY the counting code is not compiled at all, and
+ * @ref fxp_telemetry_snapshot always reports zeros.
+ */
+
+/**
+ * List of counted operations.
+ *
+ * X(name, kind) is expanded once for each operation. kind is one of
+ * OVERFLOW, SATURATION or CLIP (see @ref fxp_tm_kind).
+ */
+#define FXP_TM_LIST(X) \
+	X(f_add, OVERFLOW) \
+	X(f_sub, OVERFLOW) \
+	X(df_add, OVERFLOW) \
+	X(df_sub, OVERFLOW) \
+	X(ef_add, OVERFLOW) \
+	X(ef_sub, OVERFLOW) \
+	X(lf_add, OVERFLOW) \
+	X(lf_sub, OVERFLOW) \
+	X(ef_f_add, OVERFLOW) \
+	X(f_neg, OVERFLOW) \
+	X(df_neg, OVERFLOW) \
+	X(ef_neg, OVERFLOW) \
+	X(f_mul, OVERFLOW) \
+	X(f_mul_r, OVERFLOW) \
+	X(f_mul_cr, OVERFLOW) \
+	X(f_imul, OVERFLOW) \
+	X(f_imul_i, OVERFLOW) \
+	X(df_imul, OVERFLOW) \
+	X(ef_imul, OVERFLOW) \
+	X(f_idiv, OVERFLOW) \
+	X(df_idiv, OVERFLOW) \
+	X(ef_idiv, OVERFLOW) \
+	X(f_idivd, OVERFLOW) \
+	X(df_idivd, OVERFLOW) \
+	X(ef_idivd, OVERFLOW) \
+	X(df_shiftl, OVERFLOW) \
+	X(f_mac_lf, OVERFLOW) \
+	X(df_to_f, SATURATION) \
+	X(df_to_f_r, SATURATION) \
+	X(df_to_f_cr, SATURATION) \
+	X(ef_to_f, SATURATION) \
+	X(lf_to_df, SATURATION) \
+	X(lf_to_f, SATURATION) \
+	X(lf_to_f_r, SATURATION) \
+	X(df_addsat, SATURATION) \
+	X(df_subsat, SATURATION) \
+	X(ef_addsat, SATURATION) \
+	X(ef_subsat, SATURATION) \
+	X(f_addsat, SATURATION) \
+	X(f_subsat, SATURATION) \
+	X(f_negsat, SATURATION) \
+	X(f_mulsat, SATURATION) \
+	X(f_macs_df, SATURATION) \
+	X(f_dot_df, SATURATION) \
+	X(f_dot_macs_df, SATURATION) \
+	X(v_norm, SATURATION) \
+	X(f_clip, CLIP)
+
+/** @cond */
+#define FXP_TM_ENUM_(name, kind) FXP_TM_##name,
+/** @endcond */
+
+/**
+ * Counted operations.
+ *
+ * Each entry is named after the function, as in FXP_TM_f_add.
+ */
+typedef enum {
+	FXP_TM_LIST(FXP_TM_ENUM_)
+	FXP_TM_COUNT	/*!< Number of entries, not an operation. */
+} fxp_tm_op;
+
+/**
+ * Kinds of events.
+ */
+typedef enum {
+	FXP_TM_OVERFLOW,	/*!< The result wrapped around. */
+	FXP_TM_SATURATION,	/*!< The result was saturated. */
+	FXP_TM_CLIP		/*!< The input was clipped to a limit. */
+} fxp_tm_kind;
+
+/**
+ * Telemetry counters.
+ */
+typedef struct {
+	uint64_t calls[FXP_TM_COUNT];	/*!< Number of calls. */
+	uint64_t events[FXP_TM_COUNT];	/*!< Calls which had an event. */
+} fxp_telemetry;
+
+/**
+ * Name of an operation.
+ *
+ * @return	A static string such as "f_add", or NULL if op is not valid.
+ */
+const char *fxp_tm_name(fxp_tm_op op);
+
+/**
+ * Kind of the events of an operation.
+ */
+fxp_tm_kind fxp_tm_kind_of(fxp_tm_op op);
+
+/**
+ * Copy the counters of the calling thread.
+ *
+ * @return	true if the library was built with FXP_TELEMETRY. Otherwise,
+ *		the counters are all set to zero.
+ */
+bool fxp_telemetry_snapshot(fxp_telemetry *t);
+
+/**
+ * Set the counters of the calling thread to zero.
+ */
+void fxp_telemetry_reset(void);
+
+/** @cond */
+
+/* Overflow predicates, which do not overflow themselves */
+#define FXP_TM_ADD_OVF(a, b, min, max) \
+	(((b) > 0)? (a) > (max) - (b) : (a) < (min) - (b))
+#define FXP_TM_SUB_OVF(a, b, min, max) \
+	(((b) < 0)? (a) > (max) + (b) : (a) < (min) + (b))
+#define FXP_TM_OUT(x, min, max) ((x) < (min) || (x) > (max))
+
+#ifdef FXP_TELEMETRY
+
+#if defined(__cplusplus) && __cplusplus >= 201103L
+#define FXP_THREAD_LOCAL thread_local
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define FXP_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__)
+#define FXP_THREAD_LOCAL __thread
+#else
+#error "FXP_TELEMETRY needs thread-local storage"
+#endif
+
+extern FXP_THREAD_LOCAL fxp_telemetry fxp_tm_counters;
+
+#define FXP_TM(name, cond) (fxp_tm_counters.calls[FXP_TM_##name]++, \
+			    fxp_tm_counters.events[FXP_TM_##name] += !!(cond))
+
+#else
+
+#define FXP_TM(name, cond) ((void)0)
+
+#endif /* FXP_TELEMETRY */
+
+/** @endcond */
+
+/** @}
+ */
+
+#endif /* FXP_TELEMETRY_H */
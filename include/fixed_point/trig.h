@@ -0,0 +1,120 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Trigonometric functions of fractional angles.
+ */
+
+#ifndef FXP_TRIG_H
+#define FXP_TRIG_H
+
+#include <stddef.h>
+#include "types.h"
+
+/**
+ * @defgroup fxp_trig	Trigonometric functions
+ * @{
+ *
+ * Sine and cosine of binary angles.
+ *
+ * The angle is a @ref frac where the whole range of the type maps to a full
+ * turn: a value x represents x*pi radians, so -1 is -180 degrees and 0.5 is 90
+ * degrees. Angles wrap around naturally, so they can be accumulated with
+ * @ref f_add without any range reduction.
+ *
+ * The functions use a table with one quarter of a sine wave. The nearest
+ * table entry is corrected with a third order expansion of the angle
+ * difference, using the entry for the complementary angle as the cosine.
+ * Only integer arithmetic is used.
+ *
+ * The result is sin(pi*a) or cos(pi*a) times 2**15, rounded and clamped to
+ * +/- FRAC_MAX_V, so that f_sin is odd: the sine of -0.5 is -FRAC_MAX_V.
+ *
+ * The table has 2**FXP_TRIG_BITS + 1 entries of 16 bits. The table is part of
+ * the library, so FXP_TRIG_BITS must be defined (to a literal between 3 and
+ * 14) when building the library, not when including this header. The default
+ * is 6 (130 bytes). The maximum error over all the angles, in units of the
+ * last place of a frac:
+ *
+ * | FXP_TRIG_BITS | Table size | Max. error |
+ * |---------------|------------|------------|
+ * | 3             | 18 bytes   | 1.12 LSB   |
+ * | 4             | 34 bytes   | 1.08 LSB   |
+ * | 6             | 130 bytes  | 1.07 LSB   |
+ * | 8             | 514 bytes  | 1.04 LSB   |
+ * | 14            | 32 kbytes  | 0.50 LSB   |
+ *
+ * Rounding the table entry and the result accounts for up to 1 LSB, and the
+ * expansion for the rest. With 14 bits there is one entry per angle, so only
+ * the entry is rounded.
+ *
+ * f_sin is odd and f_cos is even, exactly, and f_sincos returns the same
+ * values as f_sin and f_cos.
+ */
+
+/**
+ * Sine of a binary angle.
+ *
+ * @param	a	Angle, in units of pi radians.
+ */
+frac f_sin(frac a);
+
+/**
+ * Cosine of a binary angle.
+ *
+ * @param	a	Angle, in units of pi radians.
+ */
+frac f_cos(frac a);
+
+/**
+ * Sine and cosine of a binary angle.
+ *
+ * This is faster than calling f_sin and f_cos separately, since the table
+ * lookups are shared.
+ *
+ * @param	a	Angle, in units of pi radians.
+ * @param	s	Output: sine of a.
+ * @param	c	Output: cosine of a.
+ */
+void f_sincos(frac a, frac *s, frac *c);
+
+/** Array version of @ref f_sin. */
+void f_sin_n(frac *dst, const frac *a, size_t n);
+
+/** Array version of @ref f_cos. */
+void f_cos_n(frac *dst, const frac *a, size_t n);
+
+/** Array version of @ref f_sincos. */
+void f_sincos_n(frac *s, frac *c, const frac *a, size_t n);
+
+/** @}
+ */
+
+#endif /* FXP_TRIG_H */
@@ -40,8 +40,10 @@
 /** This header depends only upon the definition of
  * 	- int16_t
  * 	- int32_t
+ * 	- int64_t
  * 	- INT16_MAX, INT16_MIN
  * 	- INT32_MAX, INT32_MIN
+ * 	- INT64_MAX, INT64_MIN
  * If you do not whish to (or cannot) use stdint.h, then you must provide the
  * above definitions
  */
@@ -65,6 +67,7 @@ typedef int16_t mfrac_base;	/*!< Base arithmetic type for @ref mfrac.*/
 typedef int16_t frac_base;	/*!< Base arithmetic type for @ref frac.*/
 typedef int32_t dfrac_base;	/*!< Base arithmetic type for @ref dfrac.*/
 typedef int32_t efrac_base;	/*!< Base arithmetic type for @ref efrac.*/
+typedef int64_t lfrac_base;	/*!< Base arithmetic type for @ref lfrac.*/
 
 /**
  * 16 bit fractional number in Q8.8 format.
@@ -113,6 +116,20 @@ typedef struct {
 	efrac_base v;
 } efrac;
 
+/**
+ * 64 bit fractional number in Q34.30 format.
+ *
+ * Values of this type can represent numbers between -2**33 and
+ * (2**33 - 2**-30), with the same precision as a dfrac.
+ *
+ * This is an accumulator for long sums of products of fracs: since each
+ * product is at most 1 in magnitude, more than 8 billion of them can be added
+ * without overflow, so no saturation is needed until the final narrowing.
+ */
+typedef struct {
+	lfrac_base v;
+} lfrac;
+
 /**
  * Make a dfrac from its base value.
  */
@@ -140,6 +157,15 @@ static inline efrac _efrac(efrac_base v)
 	return r;
 }
 
+/**
+ * Make a lfrac from its base value.
+ */
+static inline lfrac _lfrac(lfrac_base v)
+{
+	lfrac r = {v};
+	return r;
+}
+
 #define MFRAC_FBIT (8)  /*!< Size in bits of the fractional part of a MFRAC. */
 #define MFRAC_IBIT (8)  /*!< Size in bits of the integer part of a MFRAC. */
 #define MFRAC_BIT (16)	/*!< Size in bits of a MFRAC. */
@@ -156,6 +182,10 @@ static inline efrac _efrac(efrac_base v)
 #define EFRAC_IBIT (17)	/*!< Size in bits of the integer part of an EFRAC. */
 #define EFRAC_BIT (32)	/*!< Size in bits of an EFRAC. */
 
+#define LFRAC_FBIT (30)	/*!< Size in bits of the fractional part of a LFRAC. */
+#define LFRAC_IBIT (34)	/*!< Size in bits of the integer part of a LFRAC. */
+#define LFRAC_BIT (64)	/*!< Size in bits of a LFRAC. */
+
 /**
  * @addtogroup fxp_width
  * Width based type names.
@@ -270,6 +300,21 @@ typedef dfrac frac_s32;	/*!< 32 bit signed fractional */
 #define EFRAC_MAX_V INT32_MAX
 #define EFRAC_MIN_V INT32_MIN
 
+/** @}
+ *
+ * @defgroup lfrac_limits LFRAC Limits.
+ * @{
+ */
+
+/** Unit value for the lfrac type. */
+#define LFRAC_1_V ((lfrac_base)DFRAC_1_V)
+
+/** Maximum (most positive) value for a lfrac. */
+#define LFRAC_MAX_V INT64_MAX
+
+/** Minimum (most negative) value for a lfrac. */
+#define LFRAC_MIN_V INT64_MIN
+
 /** @}
  *
  * @defgroup frac_const FRAC Constants
@@ -279,6 +324,7 @@ typedef dfrac frac_s32;	/*!< 32 bit signed fractional */
 static const frac FZero = {0};
 static const dfrac DFZero = {0};
 static const efrac EFZero = {0};
+static const lfrac LFZero = {0};
 
 /** @}
  *  @}
@@ -306,6 +352,9 @@ static const efrac EFZero = {0};
  * @return		f represented as a frac.
  *
  * @bug		Does not round before converting.
+ *
+ * @see		fxp_array_real for conversions of whole arrays, with rounding
+ * 		and saturation.
  */
 #define REAL_TO_F(f) (_frac(-f*FRAC_minus1_V))
 
@@ -341,9 +390,17 @@ static const efrac EFZero = {0};
  */
 #define REAL_TO_EF(f) (_efrac(f*EFRAC_1_V))
 
+/**
+ * Convert a @ref lfrac to a floating point / native format.
+ *
+ * @see F_TO_REAL
+ */
+#define LF_TO_REAL(real_type, n) (((real_type)(n.v))/((real_type)LFRAC_1_V))
+
 #define F_TO_DOUBLE(n) F_TO_REAL(double, n) /*!< Convert a @ref frac to double.*/
 #define DF_TO_DOUBLE(n) DF_TO_REAL(double, n)/*!< Convert a @ref dfrac to double.*/
 #define EF_TO_DOUBLE(n) EF_TO_REAL(double, n)/*!< Convert a @ref efrac to double.*/
+#define LF_TO_DOUBLE(n) LF_TO_REAL(double, n)/*!< Convert a @ref lfrac to double.*/
 
 #define F_TO_FLOAT(n) F_TO_REAL(float, n) /*!< Convert a @ref frac to float.*/
 #define DF_TO_FLOAT(n) DF_TO_REAL(float, n)/*!< Convert a @ref dfrac to float.*/
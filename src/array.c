@@ -0,0 +1,876 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Array versions of the fixed point routines.
+ *
+ * Every function first runs a vectorized kernel over as many whole vectors as
+ * possible and then handles the remaining elements with the scalar routine.
+ * Without SIMD support, the scalar routine processes the whole array.
+ */
+
+#define FXP_DECLARATION FXP_DECLARATION_C99_HEADER
+
+#include "variant.h"
+
+#include "fixed_point/fixed_point.h"
+#include "fixed_point/array.h"
+#include "fixed_point/vector.h"
+#include "simd.h"
+#include "reduce.h"
+
+/* ######################## Function-generating macros ####################### */
+
+#ifdef FXP_SIMD
+#define SIMD_LOOP(N, body) for (; i + (N) <= n; i += (N)) { body; }
+#else
+#define SIMD_LOOP(N, body)
+#endif
+
+/**
+ * Define an array function with an element-wise operation between two arrays.
+ *
+ * @param	name	Name of the function.
+ * @param	typeR	Type of the elements of the output array.
+ * @param	typeA	Type of the elements of the first array.
+ * @param	typeB	Type of the elements of the second array.
+ * @param	f	Scalar function.
+ * @param	N	Number of elements processed by the vector operation.
+ * @param	vop	Vector operation, equivalent to f.
+ */
+#define ARRAY_OP2(name, typeR, typeA, typeB, f, N, vop) \
+void name(typeR *dst, const typeA *a, const typeB *b, size_t n) \
+{ \
+	size_t i = 0; \
+	SIMD_LOOP(N, SIMD_STORE(dst + i, vop(SIMD_LOAD(a + i), SIMD_LOAD(b + i)))) \
+	for (; i < n; i++) \
+		dst[i] = f(a[i], b[i]); \
+}
+
+/**
+ * Define an array function with an element-wise unary operation.
+ *
+ * @see	ARRAY_OP2
+ */
+#define ARRAY_OP1(name, typeR, typeA, f, N, vop) \
+void name(typeR *dst, const typeA *a, size_t n) \
+{ \
+	size_t i = 0; \
+	SIMD_LOOP(N, SIMD_STORE(dst + i, vop(SIMD_LOAD(a + i)))) \
+	for (; i < n; i++) \
+		dst[i] = f(a[i]); \
+}
+
+/**
+ * Define an array function with an operation between each element of an array
+ * and a scalar.
+ *
+ * @see	ARRAY_OP2
+ */
+#define ARRAY_OPS(name, typeR, typeA, typeB, f, N, vop) \
+void name(typeR *dst, const typeA *a, typeB b, size_t n) \
+{ \
+	size_t i = 0; \
+	SIMD_LOOP(N, SIMD_STORE(dst + i, vop(SIMD_LOAD(a + i), b))) \
+	for (; i < n; i++) \
+		dst[i] = f(a[i], b); \
+}
+
+/**
+ * Same as @ref ARRAY_OPS, for operations without a vector equivalent.
+ */
+#define ARRAY_OPS_SCALAR(name, typeR, typeA, typeB, f) \
+void name(typeR *dst, const typeA *a, typeB b, size_t n) \
+{ \
+	size_t i; \
+	for (i = 0; i < n; i++) \
+		dst[i] = f(a[i], b); \
+}
+
+/**
+ * Same as @ref ARRAY_OP2, for operations without a vector equivalent.
+ */
+#define ARRAY_OP2_SCALAR(name, typeR, typeA, typeB, f) \
+void name(typeR *dst, const typeA *a, const typeB *b, size_t n) \
+{ \
+	size_t i; \
+	for (i = 0; i < n; i++) \
+		dst[i] = f(a[i], b[i]); \
+}
+
+/**
+ * Same as @ref ARRAY_OP1, for operations without a vector equivalent.
+ */
+#define ARRAY_OP1_SCALAR(name, typeR, typeA, f) \
+void name(typeR *dst, const typeA *a, size_t n) \
+{ \
+	size_t i; \
+	for (i = 0; i < n; i++) \
+		dst[i] = f(a[i]); \
+}
+
+/* ########################### Vector operations ############################# */
+
+#ifdef FXP_SIMD
+
+/* ((a*b) << 1) >> 16, assembled from the high and low halves of the product */
+static inline simd_v simd_f_mul(simd_v a, simd_v b)
+{
+	return SIMD_OR(SIMD_SLLI16(SIMD_MULHI16(a, b), 1),
+		       SIMD_SRLI16(SIMD_MULLO16(a, b), 15));
+}
+
+/* f_mul only overflows for (-1)*(-1), which is also the only case in which it
+ * returns -1. */
+static inline simd_v simd_f_mulsat(simd_v a, simd_v b)
+{
+	simd_v p = simd_f_mul(a, b);
+
+	return SIMD_XOR(p, SIMD_CMPEQ16(p, SIMD_SET16(FRAC_MIN_V)));
+}
+
+#define simd_f_neg(x) SIMD_SUB16(SIMD_ZERO(), x)
+#define simd_f_negsat(x) SIMD_SUBS16(SIMD_ZERO(), x)
+#define simd_df_neg(x) SIMD_SUB32(SIMD_ZERO(), x)
+#define simd_f_imul(x, b) SIMD_MULLO16(x, SIMD_SET16(b))
+#define simd_df_imul(x, b) SIMD_MULLO32(x, SIMD_SET32(b))
+#define simd_df_shiftl(x, b) SIMD_SLL32(x, b)
+#define simd_df_shiftr(x, b) SIMD_SRA32(x, b)
+
+#endif /* FXP_SIMD */
+
+/* ######################### Same-width operations ########################### */
+
+ARRAY_OP2(f_add_n, frac, frac, frac, f_add, SIMD_N16, SIMD_ADD16)
+ARRAY_OP2(f_sub_n, frac, frac, frac, f_sub, SIMD_N16, SIMD_SUB16)
+ARRAY_OP2(df_add_n, dfrac, dfrac, dfrac, df_add, SIMD_N32, SIMD_ADD32)
+ARRAY_OP2(df_sub_n, dfrac, dfrac, dfrac, df_sub, SIMD_N32, SIMD_SUB32)
+ARRAY_OP2(ef_add_n, efrac, efrac, efrac, ef_add, SIMD_N32, SIMD_ADD32)
+ARRAY_OP2(ef_sub_n, efrac, efrac, efrac, ef_sub, SIMD_N32, SIMD_SUB32)
+ARRAY_OP2(df_addsat_n, dfrac, dfrac, dfrac, df_addsat, SIMD_N32, simd_adds32)
+ARRAY_OP2(df_subsat_n, dfrac, dfrac, dfrac, df_subsat, SIMD_N32, simd_subs32)
+ARRAY_OP2(ef_addsat_n, efrac, efrac, efrac, ef_addsat, SIMD_N32, simd_adds32)
+ARRAY_OP2(ef_subsat_n, efrac, efrac, efrac, ef_subsat, SIMD_N32, simd_subs32)
+ARRAY_OP2(f_addsat_n, frac, frac, frac, f_addsat, SIMD_N16, SIMD_ADDS16)
+ARRAY_OP2(f_subsat_n, frac, frac, frac, f_subsat, SIMD_N16, SIMD_SUBS16)
+ARRAY_OP2(f_mul_n, frac, frac, frac, f_mul, SIMD_N16, simd_f_mul)
+ARRAY_OP2(f_mul_r_n, frac, frac, frac, f_mul_r, SIMD_N16, SIMD_MULHRS16)
+ARRAY_OP2(f_mulsat_n, frac, frac, frac, f_mulsat, SIMD_N16, simd_f_mulsat)
+
+ARRAY_OP1(f_neg_n, frac, frac, f_neg, SIMD_N16, simd_f_neg)
+ARRAY_OP1(f_negsat_n, frac, frac, f_negsat, SIMD_N16, simd_f_negsat)
+ARRAY_OP1(df_neg_n, dfrac, dfrac, df_neg, SIMD_N32, simd_df_neg)
+ARRAY_OP1(ef_neg_n, efrac, efrac, ef_neg, SIMD_N32, simd_df_neg)
+
+ARRAY_OPS(f_imul_n, frac, frac, int16_t, f_imul, SIMD_N16, simd_f_imul)
+ARRAY_OPS(df_imul_n, dfrac, dfrac, int16_t, df_imul, SIMD_N32, simd_df_imul)
+ARRAY_OPS(ef_imul_n, efrac, efrac, int16_t, ef_imul, SIMD_N32, simd_df_imul)
+ARRAY_OPS(df_shiftl_n, dfrac, dfrac, int16_t, df_shiftl, SIMD_N32,
+	  simd_df_shiftl)
+ARRAY_OPS(df_shiftr_n, dfrac, dfrac, int16_t, df_shiftr, SIMD_N32,
+	  simd_df_shiftr)
+
+ARRAY_OPS_SCALAR(f_imul_i_n, int, frac, int, f_imul_i)
+
+/* ########################## Division by integers ########################### */
+
+/* The element-wise versions of the vector types just process 3n scalars. */
+typedef char vec3_is_packed[(sizeof(vec3) == 3 * sizeof(frac))? 1 : -1];
+typedef char dvec3_is_packed[(sizeof(dvec3) == 3 * sizeof(dfrac))? 1 : -1];
+typedef char evec3_is_packed[(sizeof(evec3) == 3 * sizeof(efrac))? 1 : -1];
+
+#ifdef FXP_SIMD
+
+/* f_idivd: (|a| * m16) >> 15 is assembled from the high and low halves of the
+ * product, and fits in 16 bits. */
+static inline simd_v simd_f_idivd(simd_v a, simd_v m16, int shift,
+				  simd_v dneg)
+{
+	simd_v sa = SIMD_SRAI16(a, 15);
+	simd_v ua = SIMD_SUB16(SIMD_XOR(a, sa), sa);
+	simd_v p = SIMD_OR(SIMD_SLLI16(SIMD_MULHIU16(ua, m16), 1),
+			   SIMD_SRLI16(SIMD_MULLO16(ua, m16), 15));
+	simd_v sq = SIMD_XOR(sa, dneg);
+
+	return SIMD_SUB16(SIMD_XOR(SIMD_SRL16(p, shift), sq), sq);
+}
+
+/* df_idivd and ef_idivd: the 64 bit products of the even and odd elements
+ * are shifted separately and merged. */
+static inline simd_v simd_idivd32(simd_v a, simd_v m, int shift, simd_v dneg)
+{
+	simd_v sa = SIMD_SRAI32(a, 31);
+	simd_v ua = SIMD_SUB32(SIMD_XOR(a, sa), sa);
+	simd_v qe = SIMD_SRL64(SIMD_MULU32(ua, m), shift);
+	simd_v qo = SIMD_SRL64(SIMD_MULU32(SIMD_SRLI64(ua, 32), m), shift);
+	simd_v sq = SIMD_XOR(sa, dneg);
+
+	return SIMD_SUB32(SIMD_XOR(SIMD_OR(qe, SIMD_SLLI64(qo, 32)), sq), sq);
+}
+
+#endif /* FXP_SIMD */
+
+void f_idivd_n(frac *dst, const frac *a, const idivider *d, size_t n)
+{
+	size_t i = 0;
+
+#ifdef FXP_SIMD
+	simd_v m16 = SIMD_SET16((int16_t)d->m16);
+	simd_v dneg = SIMD_SET16(-(int16_t)d->neg);
+
+	for (; i + SIMD_N16 <= n; i += SIMD_N16)
+		SIMD_STORE(dst + i, simd_f_idivd(SIMD_LOAD(a + i), m16,
+						 d->shift, dneg));
+#endif
+
+	for (; i < n; i++)
+		dst[i] = f_idivd(a[i], d);
+}
+
+/* Common to dfrac and efrac */
+static void idivd32_n(int32_t *dst, const int32_t *a, const idivider *d,
+		      size_t n)
+{
+	size_t i = 0;
+
+#ifdef FXP_SIMD
+	simd_v m = SIMD_SET32((int32_t)d->m);
+	simd_v dneg = SIMD_SET32(-(int32_t)d->neg);
+
+	for (; i + SIMD_N32 <= n; i += SIMD_N32)
+		SIMD_STORE(dst + i, simd_idivd32(SIMD_LOAD(a + i), m,
+						 31 + d->shift, dneg));
+#endif
+
+	for (; i < n; i++)
+		dst[i] = df_idivd(_dfrac(a[i]), d).v;
+}
+
+void df_idivd_n(dfrac *dst, const dfrac *a, const idivider *d, size_t n)
+{
+	idivd32_n(&dst->v, &a->v, d, n);
+}
+
+void ef_idivd_n(efrac *dst, const efrac *a, const idivider *d, size_t n)
+{
+	idivd32_n(&dst->v, &a->v, d, n);
+}
+
+void v_idivd_n(vec3 *dst, const vec3 *a, const idivider *d, size_t n)
+{
+	f_idivd_n(&dst->x, &a->x, d, 3 * n);
+}
+
+void dv_idivd_n(dvec3 *dst, const dvec3 *a, const idivider *d, size_t n)
+{
+	idivd32_n(&dst->x.v, &a->x.v, d, 3 * n);
+}
+
+void ev_idivd_n(evec3 *dst, const evec3 *a, const idivider *d, size_t n)
+{
+	idivd32_n(&dst->x.v, &a->x.v, d, 3 * n);
+}
+
+void f_idiv_n(frac *dst, const frac *a, int16_t b, size_t n)
+{
+	idivider d;
+
+	idiv_init(&d, b);
+	f_idivd_n(dst, a, &d, n);
+}
+
+void df_idiv_n(dfrac *dst, const dfrac *a, int16_t b, size_t n)
+{
+	idivider d;
+
+	idiv_init(&d, b);
+	df_idivd_n(dst, a, &d, n);
+}
+
+void ef_idiv_n(efrac *dst, const efrac *a, int16_t b, size_t n)
+{
+	idivider d;
+
+	idiv_init(&d, b);
+	ef_idivd_n(dst, a, &d, n);
+}
+
+void f_clip_n(frac *dst, const frac *x, frac limit, size_t n)
+{
+	size_t i = 0;
+
+#ifdef FXP_SIMD
+	simd_v hi = SIMD_SET16(limit.v);
+	simd_v lo = SIMD_SET16(-limit.v);
+
+	for (; i + SIMD_N16 <= n; i += SIMD_N16)
+		SIMD_STORE(dst + i, SIMD_MIN16(SIMD_MAX16(SIMD_LOAD(x + i), lo), hi));
+#endif
+	for (; i < n; i++)
+		dst[i] = f_clip(x[i], limit);
+}
+
+void f_ef_div_n(efrac *dst, const frac *dividend, const efrac *divisor,
+		size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		dst[i] = f_ef_div(dividend[i], divisor[i]);
+}
+
+/* ################### Widening and narrowing operations ##################### */
+
+void f_mul_df_n(dfrac *dst, const frac *a, const frac *b, size_t n)
+{
+	size_t i = 0;
+
+#ifdef FXP_SIMD
+	for (; i + SIMD_N16 <= n; i += SIMD_N16) {
+		simd_v p0, p1;
+
+		SIMD_MULW16(SIMD_LOAD(a + i), SIMD_LOAD(b + i), p0, p1);
+		SIMD_STORE(dst + i, p0);
+		SIMD_STORE(dst + i + SIMD_N32, p1);
+	}
+#endif
+	for (; i < n; i++)
+		dst[i] = f_mul_df(a[i], b[i]);
+}
+
+void f_mf_mul_ef_n(efrac *dst, const frac *a, const mfrac *b, size_t n)
+{
+	size_t i = 0;
+
+#ifdef FXP_SIMD
+	for (; i + SIMD_N16 <= n; i += SIMD_N16) {
+		simd_v p0, p1;
+
+		SIMD_MULW16(SIMD_LOAD(a + i), SIMD_LOAD(b + i), p0, p1);
+		SIMD_STORE(dst + i, SIMD_SRAI32(p0, MFRAC_FBIT));
+		SIMD_STORE(dst + i + SIMD_N32, SIMD_SRAI32(p1, MFRAC_FBIT));
+	}
+#endif
+	for (; i < n; i++)
+		dst[i] = f_mf_mul_ef(a[i], b[i]);
+}
+
+void f_imul_ef_n(efrac *dst, const frac *a, int16_t b, size_t n)
+{
+	size_t i = 0;
+
+#ifdef FXP_SIMD
+	simd_v vb = SIMD_SET16(b);
+
+	for (; i + SIMD_N16 <= n; i += SIMD_N16) {
+		simd_v p0, p1;
+
+		SIMD_MULW16(SIMD_LOAD(a + i), vb, p0, p1);
+		SIMD_STORE(dst + i, p0);
+		SIMD_STORE(dst + i + SIMD_N32, p1);
+	}
+#endif
+	for (; i < n; i++)
+		dst[i] = f_imul_ef(a[i], b);
+}
+
+void ef_f_add_n(efrac *dst, const efrac *a, const frac *b, size_t n)
+{
+	size_t i = 0;
+
+#ifdef FXP_SIMD
+	for (; i + SIMD_N16 <= n; i += SIMD_N16) {
+		simd_v b0, b1;
+
+		SIMD_EXTEND16(SIMD_LOAD(b + i), b0, b1);
+		SIMD_STORE(dst + i, SIMD_ADD32(SIMD_LOAD(a + i), b0));
+		SIMD_STORE(dst + i + SIMD_N32,
+			   SIMD_ADD32(SIMD_LOAD(a + i + SIMD_N32), b1));
+	}
+#endif
+	for (; i < n; i++)
+		dst[i] = ef_f_add(a[i], b[i]);
+}
+
+void f_to_df_n(dfrac *dst, const frac *x, size_t n)
+{
+	size_t i = 0;
+
+#ifdef FXP_SIMD
+	for (; i + SIMD_N16 <= n; i += SIMD_N16) {
+		simd_v x0, x1;
+
+		SIMD_EXTEND16(SIMD_LOAD(x + i), x0, x1);
+		SIMD_STORE(dst + i, SIMD_SLLI32(x0, FRAC_BIT - 1));
+		SIMD_STORE(dst + i + SIMD_N32, SIMD_SLLI32(x1, FRAC_BIT - 1));
+	}
+#endif
+	for (; i < n; i++)
+		dst[i] = f_to_df(x[i]);
+}
+
+void f_to_ef_n(efrac *dst, const frac *x, size_t n)
+{
+	size_t i = 0;
+
+#ifdef FXP_SIMD
+	for (; i + SIMD_N16 <= n; i += SIMD_N16) {
+		simd_v x0, x1;
+
+		SIMD_EXTEND16(SIMD_LOAD(x + i), x0, x1);
+		SIMD_STORE(dst + i, x0);
+		SIMD_STORE(dst + i + SIMD_N32, x1);
+	}
+#endif
+	for (; i < n; i++)
+		dst[i] = f_to_ef(x[i]);
+}
+
+/* For values in range, (x << 1) >> 16 is the same as x >> 15, and for values
+ * out of range the saturating pack does the same clipping as df_to_f. */
+void df_to_f_n(frac *dst, const dfrac *x, size_t n)
+{
+	size_t i = 0;
+
+#ifdef FXP_SIMD
+	for (; i + SIMD_N16 <= n; i += SIMD_N16) {
+		simd_v x0 = SIMD_SRAI32(SIMD_LOAD(x + i), FRAC_BIT - 1);
+		simd_v x1 = SIMD_SRAI32(SIMD_LOAD(x + i + SIMD_N32), FRAC_BIT - 1);
+
+		SIMD_STORE(dst + i, SIMD_PACKS32(x0, x1));
+	}
+#endif
+	for (; i < n; i++)
+		dst[i] = df_to_f(x[i]);
+}
+
+void df_to_f_r_n(frac *dst, const dfrac *x, size_t n)
+{
+	size_t i = 0;
+
+#ifdef FXP_SIMD
+	simd_v half = SIMD_SET32(1 << (FRAC_BIT - 2));
+
+	for (; i + SIMD_N16 <= n; i += SIMD_N16) {
+		simd_v x0 = simd_adds32(SIMD_LOAD(x + i), half);
+		simd_v x1 = simd_adds32(SIMD_LOAD(x + i + SIMD_N32), half);
+
+		SIMD_STORE(dst + i, SIMD_PACKS32(SIMD_SRAI32(x0, FRAC_BIT - 1),
+						 SIMD_SRAI32(x1, FRAC_BIT - 1)));
+	}
+#endif
+	for (; i < n; i++)
+		dst[i] = df_to_f_r(x[i]);
+}
+
+void df_to_f_cr_n(frac *dst, const dfrac *x, size_t n)
+{
+	size_t i = 0;
+
+#ifdef FXP_SIMD
+	for (; i + SIMD_N16 <= n; i += SIMD_N16)
+		SIMD_STORE(dst + i, SIMD_PACKS32(
+				simd_round_even(SIMD_LOAD(x + i), FRAC_BIT - 1),
+				simd_round_even(SIMD_LOAD(x + i + SIMD_N32),
+						FRAC_BIT - 1)));
+#endif
+	for (; i < n; i++)
+		dst[i] = df_to_f_cr(x[i]);
+}
+
+/* The wide products cannot saturate when rounded, and (-1)*(-1) must wrap
+ * around as in the scalar routine. */
+void f_mul_cr_n(frac *dst, const frac *a, const frac *b, size_t n)
+{
+	size_t i = 0;
+
+#ifdef FXP_SIMD
+	for (; i + SIMD_N16 <= n; i += SIMD_N16) {
+		simd_v p0, p1;
+
+		SIMD_MULW16(SIMD_LOAD(a + i), SIMD_LOAD(b + i), p0, p1);
+		SIMD_STORE(dst + i,
+			   SIMD_PACK32(simd_round_even(p0, FRAC_BIT - 1),
+				       simd_round_even(p1, FRAC_BIT - 1)));
+	}
+#endif
+	for (; i < n; i++)
+		dst[i] = f_mul_cr(a[i], b[i]);
+}
+
+void ef_to_f_n(frac *dst, const efrac *x, size_t n)
+{
+	size_t i = 0;
+
+#ifdef FXP_SIMD
+	for (; i + SIMD_N16 <= n; i += SIMD_N16)
+		SIMD_STORE(dst + i, SIMD_PACKS32(SIMD_LOAD(x + i),
+						 SIMD_LOAD(x + i + SIMD_N32)));
+#endif
+	for (; i < n; i++)
+		dst[i] = ef_to_f(x[i]);
+}
+
+void f_macs_df_n(dfrac *acc, const frac *x, const frac *y, size_t n)
+{
+	size_t i = 0;
+
+#ifdef FXP_SIMD
+	for (; i + SIMD_N16 <= n; i += SIMD_N16) {
+		simd_v p0, p1;
+
+		SIMD_MULW16(SIMD_LOAD(x + i), SIMD_LOAD(y + i), p0, p1);
+		SIMD_STORE(acc + i, simd_adds32(SIMD_LOAD(acc + i), p0));
+		SIMD_STORE(acc + i + SIMD_N32,
+			   simd_adds32(SIMD_LOAD(acc + i + SIMD_N32), p1));
+	}
+#endif
+	for (; i < n; i++)
+		acc[i] = f_macs_df(x[i], y[i], acc[i]);
+}
+
+/* ################# Conversion to and from floating point ################### */
+
+/* Round to nearest (ties to even) and saturate to 32 bits, NaN becomes 0.
+ * This is what the vector conversions do in the default rounding mode. */
+static inline int32_t real_to_raw(double y)
+{
+	int32_t r;
+	double d;
+
+	if (!(y == y))
+		return 0;
+	if (y >= (double)INT32_MAX)
+		return INT32_MAX;
+	if (y <= (double)INT32_MIN)
+		return INT32_MIN;
+
+	r = (int32_t)y;
+	d = y - r;
+	if (d > 0.5 || (d == 0.5 && (r & 1)))
+		r++;
+	else if (d < -0.5 || (d == -0.5 && (r & 1)))
+		r--;
+
+	return r;
+}
+
+static inline frac_base real_to_raw16(double y)
+{
+	int32_t r = real_to_raw(y);
+
+	return (r > FRAC_MAX_V)? FRAC_MAX_V
+		: ((r < FRAC_MIN_V)? FRAC_MIN_V : (frac_base)r);
+}
+
+#ifdef FXP_SIMD
+
+/* Positive overflow converts to INT32_MIN, and is flipped to INT32_MAX by the
+ * mask. Negative overflow already gives INT32_MIN. */
+static inline simd_v simd_float_to_raw(simd_vf x, simd_vf scale)
+{
+	simd_vf y = SIMD_ZNANF(SIMD_MULF(x, scale));
+
+	return SIMD_XOR(SIMD_CVTF32(y),
+			SIMD_CMPGEF(y, SIMD_SETF(2147483648.0f)));
+}
+
+/* The range of int32 is exactly representable as double, so here the input
+ * can be clamped before conversion. */
+static inline simd_v simd_double_to_raw(simd_vd a, simd_vd b, simd_vd scale)
+{
+	simd_vd lo = SIMD_SETD(INT32_MIN), hi = SIMD_SETD(INT32_MAX);
+
+	a = SIMD_MIND(SIMD_MAXD(SIMD_ZNAND(SIMD_MULD(a, scale)), lo), hi);
+	b = SIMD_MIND(SIMD_MAXD(SIMD_ZNAND(SIMD_MULD(b, scale)), lo), hi);
+
+	return SIMD_CVTD32(a, b);
+}
+
+#endif /* FXP_SIMD */
+
+/* Common to dfrac and efrac */
+static void float_to_raw32_n(int32_t *dst, const float *x, int fbit, size_t n)
+{
+	size_t i = 0;
+	float scale = (float)((int32_t)1 << fbit);
+
+#ifdef FXP_SIMD
+	simd_vf vscale = SIMD_SETF(scale);
+
+	for (; i + SIMD_N32 <= n; i += SIMD_N32)
+		SIMD_STORE(dst + i, simd_float_to_raw(SIMD_LOADF(x + i), vscale));
+#endif
+	for (; i < n; i++)
+		dst[i] = real_to_raw((double)x[i] * scale);
+}
+
+static void double_to_raw32_n(int32_t *dst, const double *x, int fbit,
+			      size_t n)
+{
+	size_t i = 0;
+	double scale = (double)((int32_t)1 << fbit);
+
+#ifdef FXP_SIMD
+	simd_vd vscale = SIMD_SETD(scale);
+
+	for (; i + SIMD_N32 <= n; i += SIMD_N32)
+		SIMD_STORE(dst + i, simd_double_to_raw(SIMD_LOADD(x + i),
+				SIMD_LOADD(x + i + SIMD_N64), vscale));
+#endif
+	for (; i < n; i++)
+		dst[i] = real_to_raw(x[i] * scale);
+}
+
+static void raw32_to_float_n(float *dst, const int32_t *x, int fbit, size_t n)
+{
+	size_t i = 0;
+	float scale = 1.0f / (float)((int32_t)1 << fbit);
+
+#ifdef FXP_SIMD
+	simd_vf vscale = SIMD_SETF(scale);
+
+	for (; i + SIMD_N32 <= n; i += SIMD_N32)
+		SIMD_STOREF(dst + i, SIMD_MULF(SIMD_CVT32F(SIMD_LOAD(x + i)),
+					       vscale));
+#endif
+	for (; i < n; i++)
+		dst[i] = (float)x[i] * scale;
+}
+
+static void raw32_to_double_n(double *dst, const int32_t *x, int fbit,
+			      size_t n)
+{
+	size_t i = 0;
+	double scale = 1.0 / (double)((int32_t)1 << fbit);
+
+#ifdef FXP_SIMD
+	simd_vd vscale = SIMD_SETD(scale);
+
+	for (; i + SIMD_N32 <= n; i += SIMD_N32) {
+		simd_vd x0, x1;
+
+		SIMD_CVT32D(SIMD_LOAD(x + i), x0, x1);
+		SIMD_STORED(dst + i, SIMD_MULD(x0, vscale));
+		SIMD_STORED(dst + i + SIMD_N64, SIMD_MULD(x1, vscale));
+	}
+#endif
+	for (; i < n; i++)
+		dst[i] = x[i] * scale;
+}
+
+void float_to_f_n(frac *dst, const float *x, size_t n)
+{
+	size_t i = 0;
+	float scale = (float)(1 << FRAC_FBIT);
+
+#ifdef FXP_SIMD
+	simd_vf vscale = SIMD_SETF(scale);
+
+	for (; i + SIMD_N16 <= n; i += SIMD_N16)
+		SIMD_STORE(dst + i, SIMD_PACKS32(
+			simd_float_to_raw(SIMD_LOADF(x + i), vscale),
+			simd_float_to_raw(SIMD_LOADF(x + i + SIMD_N32), vscale)));
+#endif
+	for (; i < n; i++)
+		dst[i] = _frac(real_to_raw16((double)x[i] * scale));
+}
+
+void float_to_df_n(dfrac *dst, const float *x, size_t n)
+{
+	float_to_raw32_n(&dst->v, x, DFRAC_FBIT, n);
+}
+
+void float_to_ef_n(efrac *dst, const float *x, size_t n)
+{
+	float_to_raw32_n(&dst->v, x, EFRAC_FBIT, n);
+}
+
+void double_to_f_n(frac *dst, const double *x, size_t n)
+{
+	size_t i = 0;
+	double scale = (double)(1 << FRAC_FBIT);
+
+#ifdef FXP_SIMD
+	simd_vd vscale = SIMD_SETD(scale);
+
+	for (; i + SIMD_N16 <= n; i += SIMD_N16) {
+		const double *xi = x + i;
+
+		SIMD_STORE(dst + i, SIMD_PACKS32(
+			simd_double_to_raw(SIMD_LOADD(xi),
+					   SIMD_LOADD(xi + SIMD_N64), vscale),
+			simd_double_to_raw(SIMD_LOADD(xi + 2 * SIMD_N64),
+					   SIMD_LOADD(xi + 3 * SIMD_N64),
+					   vscale)));
+	}
+#endif
+	for (; i < n; i++)
+		dst[i] = _frac(real_to_raw16(x[i] * scale));
+}
+
+void double_to_df_n(dfrac *dst, const double *x, size_t n)
+{
+	double_to_raw32_n(&dst->v, x, DFRAC_FBIT, n);
+}
+
+void double_to_ef_n(efrac *dst, const double *x, size_t n)
+{
+	double_to_raw32_n(&dst->v, x, EFRAC_FBIT, n);
+}
+
+void f_to_float_n(float *dst, const frac *x, size_t n)
+{
+	size_t i = 0;
+	float scale = 1.0f / (float)(1 << FRAC_FBIT);
+
+#ifdef FXP_SIMD
+	simd_vf vscale = SIMD_SETF(scale);
+
+	for (; i + SIMD_N16 <= n; i += SIMD_N16) {
+		simd_v x0, x1;
+
+		SIMD_EXTEND16(SIMD_LOAD(x + i), x0, x1);
+		SIMD_STOREF(dst + i, SIMD_MULF(SIMD_CVT32F(x0), vscale));
+		SIMD_STOREF(dst + i + SIMD_N32,
+			    SIMD_MULF(SIMD_CVT32F(x1), vscale));
+	}
+#endif
+	for (; i < n; i++)
+		dst[i] = (float)x[i].v * scale;
+}
+
+void df_to_float_n(float *dst, const dfrac *x, size_t n)
+{
+	raw32_to_float_n(dst, &x->v, DFRAC_FBIT, n);
+}
+
+void ef_to_float_n(float *dst, const efrac *x, size_t n)
+{
+	raw32_to_float_n(dst, &x->v, EFRAC_FBIT, n);
+}
+
+void f_to_double_n(double *dst, const frac *x, size_t n)
+{
+	size_t i = 0;
+	double scale = 1.0 / (double)(1 << FRAC_FBIT);
+
+#ifdef FXP_SIMD
+	simd_vd vscale = SIMD_SETD(scale);
+
+	for (; i + SIMD_N16 <= n; i += SIMD_N16) {
+		simd_v x0, x1;
+		simd_vd d0, d1;
+
+		SIMD_EXTEND16(SIMD_LOAD(x + i), x0, x1);
+		SIMD_CVT32D(x0, d0, d1);
+		SIMD_STORED(dst + i, SIMD_MULD(d0, vscale));
+		SIMD_STORED(dst + i + SIMD_N64, SIMD_MULD(d1, vscale));
+		SIMD_CVT32D(x1, d0, d1);
+		SIMD_STORED(dst + i + 2 * SIMD_N64, SIMD_MULD(d0, vscale));
+		SIMD_STORED(dst + i + 3 * SIMD_N64, SIMD_MULD(d1, vscale));
+	}
+#endif
+	for (; i < n; i++)
+		dst[i] = x[i].v * scale;
+}
+
+void df_to_double_n(double *dst, const dfrac *x, size_t n)
+{
+	raw32_to_double_n(dst, &x->v, DFRAC_FBIT, n);
+}
+
+void ef_to_double_n(double *dst, const efrac *x, size_t n)
+{
+	raw32_to_double_n(dst, &x->v, EFRAC_FBIT, n);
+}
+
+/* ########################## Geometric operations ########################### */
+
+/* The components of packed vectors do not line up with the vector registers.
+ * These loops are left to the compiler, which can still vectorize them in the
+ * builds for wider instruction sets. */
+ARRAY_OP2_SCALAR(v_dot_df_n, dfrac, vec3, vec3, v_dot_df)
+ARRAY_OP1_SCALAR(v_norm2_df_n, dfrac, vec3, v_norm2_df)
+ARRAY_OP2_SCALAR(v_cross_n, vec3, vec3, vec3, v_cross)
+ARRAY_OP2_SCALAR(v_cross_dv_n, dvec3, vec3, vec3, v_cross_dv)
+
+/* ############################### Reductions ################################ */
+
+dfrac f_dot_df(const frac *x, const frac *y, size_t n)
+{
+	int64_t sum = f_dot_raw(x, y, n);
+
+	FXP_TM(f_dot_df, FXP_TM_OUT(sum, DFRAC_MIN_V, DFRAC_MAX_V));
+	return sat_df(sum);
+}
+
+dfrac f_dot_macs_df(dfrac z, const frac *x, const frac *y, size_t n)
+{
+	int64_t sum = z.v + f_dot_raw(x, y, n);
+
+	FXP_TM(f_dot_macs_df, FXP_TM_OUT(sum, DFRAC_MIN_V, DFRAC_MAX_V));
+	return sat_df(sum);
+}
+
+lfrac f_dot_lf(const frac *x, const frac *y, size_t n)
+{
+	return _lfrac(f_dot_raw(x, y, n));
+}
+
+lfrac f_dot_mac_lf(lfrac z, const frac *x, const frac *y, size_t n)
+{
+	return _lfrac(z.v + f_dot_raw(x, y, n));
+}
+
+/* The elements are sign-extended to 64 bits. Their order does not matter for
+ * the sum, so the unpack instructions can be used directly. */
+lfrac df_sum_lf(const dfrac *x, size_t n)
+{
+	int64_t sum = 0;
+	size_t i = 0;
+
+#ifdef FXP_SIMD
+	simd_v acc = SIMD_ZERO();
+
+	for (; i + SIMD_N32 <= n; i += SIMD_N32) {
+		simd_v v = SIMD_LOAD(x + i);
+		simd_v s = SIMD_SRAI32(v, 31);
+
+		acc = SIMD_ADD64(acc, SIMD_UNPACKLO32(v, s));
+		acc = SIMD_ADD64(acc, SIMD_UNPACKHI32(v, s));
+	}
+	sum = simd_hsum64(acc);
+#endif
+	for (; i < n; i++)
+		sum += x[i].v;
+
+	return _lfrac(sum);
+}
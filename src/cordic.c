@@ -0,0 +1,490 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * CORDIC engine.
+ *
+ * Internally, coordinates are Q3.29 and angles are 32 bit binary angles (2**31
+ * is pi), so that angles wrap around with unsigned arithmetic.
+ */
+
+#include <stdint.h>
+
+#define FXP_DECLARATION FXP_DECLARATION_C99_HEADER
+
+#include "variant.h"
+
+#include "fixed_point/fixed_point.h"
+#include "fixed_point/cordic.h"
+#include "reduce.h"
+#include "simd.h"
+
+#ifndef FXP_CORDIC_ITER
+#define FXP_CORDIC_ITER 18
+#endif
+
+#if FXP_CORDIC_ITER < 1 || FXP_CORDIC_ITER > CORDIC_MAX_ITER
+#error "FXP_CORDIC_ITER must be between 1 and CORDIC_MAX_ITER"
+#endif
+
+#define ANGLE_PI 0x80000000u
+
+/* atan(2**-i) */
+static const uint32_t atan_table[CORDIC_MAX_ITER] = {
+	536870912, 316933406, 167458907, 85004756, 42667331, 21354465,
+	10679838, 5340245, 2670163, 1335087, 667544, 333772, 166886, 83443,
+	41722, 20861, 10430, 5215, 2608, 1304, 652, 326, 163, 81, 41, 20, 10,
+	5, 3, 1
+};
+
+/* Inverse of the gain after n iterations, in Q30, at gain_table[n - 1] */
+static const int32_t gain_table[CORDIC_MAX_ITER] = {
+	759250125, 679093957, 658817909, 653730436, 652457347, 652138997,
+	652059405, 652039507, 652034532, 652033289, 652032978, 652032900,
+	652032881, 652032876, 652032874, 652032874, 652032874, 652032874,
+	652032874, 652032874, 652032874, 652032874, 652032874, 652032874,
+	652032874, 652032874, 652032874, 652032874, 652032874, 652032874
+};
+
+/* Rotate (x, y) by z. The vector is first rotated by pi if the angle is not in
+ * [-pi/2, pi/2), since the iterations converge for about +-0.55*pi. */
+static inline void rotation(int32_t *px, int32_t *py, uint32_t z, int iter)
+{
+	int32_t x = *px, y = *py;
+	int i;
+
+	if ((int32_t)(z ^ (z << 1)) < 0) {
+		x = -x;
+		y = -y;
+		z += ANGLE_PI;
+	}
+
+	for (i = 0; i < iter; i++) {
+		int32_t xs = x >> i, ys = y >> i;
+
+		if ((int32_t)z >= 0) {
+			x -= ys;
+			y += xs;
+			z -= atan_table[i];
+		} else {
+			x += ys;
+			y -= xs;
+			z += atan_table[i];
+		}
+	}
+
+	*px = x;
+	*py = y;
+}
+
+/* Rotate (x, y) to the positive x axis. x becomes the magnitude and the
+ * return value is the angle of the vector. */
+static inline uint32_t vectoring(int32_t *px, int32_t y, int iter)
+{
+	int32_t x = *px;
+	uint32_t z = 0;
+	int i;
+
+	if (x < 0) {
+		x = -x;
+		y = -y;
+		z = ANGLE_PI;
+	}
+
+	for (i = 0; i < iter; i++) {
+		int32_t xs = x >> i, ys = y >> i;
+
+		if (y < 0) {
+			x -= ys;
+			y += xs;
+			z -= atan_table[i];
+		} else {
+			x += ys;
+			y -= xs;
+			z += atan_table[i];
+		}
+	}
+
+	*px = x;
+	return z;
+}
+
+/* frac to Q3.29, multiplied by the gain k. The constant is split in two parts
+ * of 15 bits, so that only 16x16 bit products are needed. */
+static inline int32_t f_in(frac x, int32_t k)
+{
+	return ((x.v * (k >> 15)) >> 1) + ((x.v * (k & 0x7FFF)) >> 16);
+}
+
+static inline frac f_out(int32_t x)
+{
+	return ef_to_f(_efrac((x + (1 << 13)) >> 14));
+}
+
+static inline uint32_t f_angle_in(frac a)
+{
+	return (uint32_t)(uint16_t)a.v << 16;
+}
+
+static inline frac f_angle_out(uint32_t z)
+{
+	return _frac((frac_base)((int32_t)(z + 0x8000u) >> 16));
+}
+
+static inline int32_t df_in(dfrac x, int32_t k)
+{
+	return (int32_t)(((int64_t)x.v * k) >> 31);
+}
+
+static inline dfrac df_out(int32_t x)
+{
+	return sat_df((int64_t)x * 2);
+}
+
+static inline uint32_t df_angle_in(dfrac a)
+{
+	return (uint32_t)a.v << 1;
+}
+
+static inline dfrac df_angle_out(uint32_t z)
+{
+	return _dfrac((int32_t)(z + 1) >> 1);
+}
+
+#define F_GAIN gain_table[FXP_CORDIC_ITER - 1]
+
+frac f_atan2(frac y, frac x)
+{
+	int32_t cx = f_in(x, F_GAIN);
+
+	return f_angle_out(vectoring(&cx, f_in(y, F_GAIN), FXP_CORDIC_ITER));
+}
+
+frac f_hypot(frac x, frac y)
+{
+	int32_t cx = f_in(x, F_GAIN);
+
+	vectoring(&cx, f_in(y, F_GAIN), FXP_CORDIC_ITER);
+
+	return f_out(cx);
+}
+
+void f_to_polar(frac x, frac y, frac *r, frac *a)
+{
+	int32_t cx = f_in(x, F_GAIN);
+
+	*a = f_angle_out(vectoring(&cx, f_in(y, F_GAIN), FXP_CORDIC_ITER));
+	*r = f_out(cx);
+}
+
+void f_from_polar(frac r, frac a, frac *x, frac *y)
+{
+	int32_t cx = f_in(r, F_GAIN), cy = 0;
+
+	rotation(&cx, &cy, f_angle_in(a), FXP_CORDIC_ITER);
+	*x = f_out(cx);
+	*y = f_out(cy);
+}
+
+void f_rotate(frac *x, frac *y, frac a)
+{
+	int32_t cx = f_in(*x, F_GAIN), cy = f_in(*y, F_GAIN);
+
+	rotation(&cx, &cy, f_angle_in(a), FXP_CORDIC_ITER);
+	*x = f_out(cx);
+	*y = f_out(cy);
+}
+
+static inline int cordic_clz32(uint32_t x)
+{
+#ifdef __GNUC__
+	return __builtin_clz(x);
+#else
+	int n = 0;
+
+	for (; !(x & 0x80000000u); x <<= 1)
+		n++;
+
+	return n;
+#endif
+}
+
+/* Both coordinates are first scaled by the same power of 2, so that the
+ * largest one uses all the bits. Otherwise the shifted terms of the last
+ * iterations of a small vector would be 0. The angle does not change with the
+ * scaling, and the magnitude is scaled back (with rounding) at the end. */
+void df_cordic_polar(dfrac x, dfrac y, dfrac *r, dfrac *a, int iter)
+{
+	int32_t k = gain_table[iter - 1];
+	/* The one's complement ignores the sign, and x.v = -2**(31 - s) still
+	 * fits after the scaling. */
+	uint32_t m = (uint32_t)(x.v ^ (x.v >> 31))
+		     | (uint32_t)(y.v ^ (y.v >> 31));
+	int s = cordic_clz32(m | 1) - 1;
+	int32_t cx = df_in(_dfrac(x.v * ((int32_t)1 << s)), k);
+	int32_t cy = df_in(_dfrac(y.v * ((int32_t)1 << s)), k);
+
+	*a = df_angle_out(vectoring(&cx, cy, iter));
+	*r = sat_df(((int64_t)cx * 2 + (((int64_t)1 << s) >> 1)) >> s);
+}
+
+void df_cordic_rotate(dfrac *x, dfrac *y, dfrac a, int iter)
+{
+	int32_t k = gain_table[iter - 1];
+	int32_t cx = df_in(*x, k), cy = df_in(*y, k);
+
+	rotation(&cx, &cy, df_angle_in(a), iter);
+	*x = df_out(cx);
+	*y = df_out(cy);
+}
+
+dfrac df_atan2(dfrac y, dfrac x)
+{
+	dfrac r, a;
+
+	df_cordic_polar(x, y, &r, &a, CORDIC_MAX_ITER);
+
+	return a;
+}
+
+dfrac df_hypot(dfrac x, dfrac y)
+{
+	dfrac r, a;
+
+	df_cordic_polar(x, y, &r, &a, CORDIC_MAX_ITER);
+
+	return r;
+}
+
+void df_to_polar(dfrac x, dfrac y, dfrac *r, dfrac *a)
+{
+	df_cordic_polar(x, y, r, a, CORDIC_MAX_ITER);
+}
+
+void df_from_polar(dfrac r, dfrac a, dfrac *x, dfrac *y)
+{
+	*x = r;
+	*y = _dfrac(0);
+	df_cordic_rotate(x, y, a, CORDIC_MAX_ITER);
+}
+
+void df_rotate(dfrac *x, dfrac *y, dfrac a)
+{
+	df_cordic_rotate(x, y, a, CORDIC_MAX_ITER);
+}
+
+/* Array versions.
+ *
+ * The SIMD kernels work on SIMD_N16 elements at a time, as two vectors of 32
+ * bit lanes. Both vectors are processed in the same loop, since each iteration
+ * depends on the previous one. The conditional add/subtract of the iterations
+ * is done by negating with a mask: (v ^ m) - m is -v if m is all ones, v if m
+ * is 0. */
+
+#ifdef FXP_SIMD
+
+static inline simd_v simd_cneg(simd_v v, simd_v m)
+{
+	return SIMD_SUB32(SIMD_XOR(v, m), m);
+}
+
+static inline void simd_rotation(simd_v x[2], simd_v y[2], simd_v z[2])
+{
+	int i, j;
+
+	for (j = 0; j < 2; j++) {
+		simd_v m = SIMD_SRAI32(SIMD_XOR(z[j], SIMD_SLLI32(z[j], 1)), 31);
+
+		x[j] = simd_cneg(x[j], m);
+		y[j] = simd_cneg(y[j], m);
+		z[j] = SIMD_ADD32(z[j], SIMD_AND(m, SIMD_SET32(INT32_MIN)));
+	}
+
+	for (i = 0; i < FXP_CORDIC_ITER; i++) {
+		simd_v a = SIMD_SET32(atan_table[i]);
+
+		for (j = 0; j < 2; j++) {
+			simd_v xs = SIMD_SRA32(x[j], i), ys = SIMD_SRA32(y[j], i);
+			simd_v m = SIMD_SRAI32(z[j], 31);
+
+			x[j] = SIMD_SUB32(x[j], simd_cneg(ys, m));
+			y[j] = SIMD_ADD32(y[j], simd_cneg(xs, m));
+			z[j] = SIMD_SUB32(z[j], simd_cneg(a, m));
+		}
+	}
+}
+
+static inline void simd_vectoring(simd_v x[2], simd_v y[2], simd_v z[2])
+{
+	int i, j;
+
+	for (j = 0; j < 2; j++) {
+		simd_v m = SIMD_SRAI32(x[j], 31);
+
+		x[j] = simd_cneg(x[j], m);
+		y[j] = simd_cneg(y[j], m);
+		z[j] = SIMD_AND(m, SIMD_SET32(INT32_MIN));
+	}
+
+	for (i = 0; i < FXP_CORDIC_ITER; i++) {
+		simd_v a = SIMD_SET32(atan_table[i]);
+
+		for (j = 0; j < 2; j++) {
+			simd_v xs = SIMD_SRA32(x[j], i), ys = SIMD_SRA32(y[j], i);
+			simd_v m = SIMD_XOR(SIMD_SRAI32(y[j], 31),
+					    SIMD_SET32(-1));
+
+			x[j] = SIMD_SUB32(x[j], simd_cneg(ys, m));
+			y[j] = SIMD_ADD32(y[j], simd_cneg(xs, m));
+			z[j] = SIMD_SUB32(z[j], simd_cneg(a, m));
+		}
+	}
+}
+
+/* Same as f_in, for sign extended fracs */
+static inline simd_v simd_f_in(simd_v x)
+{
+	simd_v hi = SIMD_MADD16(x, SIMD_SET32(F_GAIN >> 15));
+	simd_v lo = SIMD_MADD16(x, SIMD_SET32(F_GAIN & 0x7FFF));
+
+	return SIMD_ADD32(SIMD_SRAI32(hi, 1), SIMD_SRAI32(lo, 16));
+}
+
+static inline simd_v simd_f_out(const simd_v x[2])
+{
+	return SIMD_PACKS32(
+		SIMD_SRAI32(SIMD_ADD32(x[0], SIMD_SET32(1 << 13)), 14),
+		SIMD_SRAI32(SIMD_ADD32(x[1], SIMD_SET32(1 << 13)), 14));
+}
+
+static inline simd_v simd_f_angle_out(const simd_v z[2])
+{
+	return SIMD_PACKS32(
+		SIMD_SRAI32(SIMD_ADD32(z[0], SIMD_SET32(0x8000)), 16),
+		SIMD_SRAI32(SIMD_ADD32(z[1], SIMD_SET32(0x8000)), 16));
+}
+
+/* Load SIMD_N16 fracs, in Q3.29 with the gain applied */
+static inline void simd_f_in_load(simd_v x[2], const frac *p)
+{
+	SIMD_EXTEND16(SIMD_LOAD(p), x[0], x[1]);
+	x[0] = simd_f_in(x[0]);
+	x[1] = simd_f_in(x[1]);
+}
+
+/* Load SIMD_N16 angles */
+static inline void simd_angle_load(simd_v z[2], const frac *p)
+{
+	SIMD_EXTEND16(SIMD_LOAD(p), z[0], z[1]);
+	z[0] = SIMD_SLLI32(z[0], 16);
+	z[1] = SIMD_SLLI32(z[1], 16);
+}
+
+#endif /* FXP_SIMD */
+
+void f_to_polar_n(frac *r, frac *a, const frac *x, const frac *y, size_t n)
+{
+	size_t i = 0;
+
+#ifdef FXP_SIMD
+	for (; i + SIMD_N16 <= n; i += SIMD_N16) {
+		simd_v vx[2], vy[2], vz[2];
+
+		simd_f_in_load(vx, x + i);
+		simd_f_in_load(vy, y + i);
+		simd_vectoring(vx, vy, vz);
+		if (r != NULL)
+			SIMD_STORE(r + i, simd_f_out(vx));
+		if (a != NULL)
+			SIMD_STORE(a + i, simd_f_angle_out(vz));
+	}
+#endif /* FXP_SIMD */
+
+	for (; i < n; i++) {
+		int32_t cx = f_in(x[i], F_GAIN);
+		uint32_t z = vectoring(&cx, f_in(y[i], F_GAIN), FXP_CORDIC_ITER);
+
+		if (r != NULL)
+			r[i] = f_out(cx);
+		if (a != NULL)
+			a[i] = f_angle_out(z);
+	}
+}
+
+void f_atan2_n(frac *dst, const frac *y, const frac *x, size_t n)
+{
+	f_to_polar_n(NULL, dst, x, y, n);
+}
+
+void f_hypot_n(frac *dst, const frac *x, const frac *y, size_t n)
+{
+	f_to_polar_n(dst, NULL, x, y, n);
+}
+
+void f_from_polar_n(frac *x, frac *y, const frac *r, const frac *a, size_t n)
+{
+	size_t i = 0;
+
+#ifdef FXP_SIMD
+	for (; i + SIMD_N16 <= n; i += SIMD_N16) {
+		simd_v vx[2], vy[2] = {SIMD_ZERO(), SIMD_ZERO()}, vz[2];
+
+		simd_f_in_load(vx, r + i);
+		simd_angle_load(vz, a + i);
+		simd_rotation(vx, vy, vz);
+		SIMD_STORE(x + i, simd_f_out(vx));
+		SIMD_STORE(y + i, simd_f_out(vy));
+	}
+#endif /* FXP_SIMD */
+
+	for (; i < n; i++)
+		f_from_polar(r[i], a[i], x + i, y + i);
+}
+
+void f_rotate_n(frac *x, frac *y, const frac *a, size_t n)
+{
+	size_t i = 0;
+
+#ifdef FXP_SIMD
+	for (; i + SIMD_N16 <= n; i += SIMD_N16) {
+		simd_v vx[2], vy[2], vz[2];
+
+		simd_f_in_load(vx, x + i);
+		simd_f_in_load(vy, y + i);
+		simd_angle_load(vz, a + i);
+		simd_rotation(vx, vy, vz);
+		SIMD_STORE(x + i, simd_f_out(vx));
+		SIMD_STORE(y + i, simd_f_out(vy));
+	}
+#endif /* FXP_SIMD */
+
+	for (; i < n; i++)
+		f_rotate(x + i, y + i, a[i]);
+}
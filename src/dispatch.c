@@ -0,0 +1,233 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Runtime selection of the vectorized kernels.
+ *
+ * With runtime dispatch, the public names of the functions in
+ * FXP_DISPATCH_LIST are defined here as wrappers that call through a table of
+ * function pointers, one table per instruction set. The active table starts
+ * out pointing to stubs that select the best table on the first call.
+ *
+ * Without it, only the query functions are defined and they report the
+ * instruction set the library was compiled for.
+ */
+
+#define FXP_DECLARATION FXP_DECLARATION_C99_HEADER
+
+#include <stddef.h>
+#include "fixed_point/dispatch.h"
+
+static const char *const isa_names[FXP_ISA_COUNT] = {
+	"generic", "sse2", "avx2", "avx512"
+};
+
+const char *fxp_isa_name(fxp_isa isa)
+{
+	return ((unsigned)isa < FXP_ISA_COUNT) ? isa_names[isa] : NULL;
+}
+
+#ifdef FXP_DISPATCH
+
+#if !defined(__GNUC__) || !(defined(__x86_64__) || defined(__i386__))
+#error "Runtime dispatch is only supported for x86 with GCC or Clang"
+#endif
+
+#include "fixed_point/fixed_point.h"
+#include "fixed_point/array.h"
+#include "fixed_point/cordic.h"
+#include "fixed_point/fft.h"
+#include "fixed_point/filter.h"
+#include "fixed_point/quaternion.h"
+#include "fixed_point/soa.h"
+#include "variant.h"
+
+/* ###################### Function pointer tables ########################### */
+
+#define PROTO_V(S, name, params, args) void FXP_CAT(name, S) params;
+#define PROTO_R(S, type, name, params, args) type FXP_CAT(name, S) params;
+
+FXP_DISPATCH_LIST(PROTO_V, PROTO_R, generic)
+FXP_DISPATCH_LIST(PROTO_V, PROTO_R, sse2)
+FXP_DISPATCH_LIST(PROTO_V, PROTO_R, avx2)
+FXP_DISPATCH_LIST(PROTO_V, PROTO_R, avx512)
+
+#define SLOT_V(S, name, params, args) void (*name) params;
+#define SLOT_R(S, type, name, params, args) type (*name) params;
+
+struct kernels {
+	FXP_DISPATCH_LIST(SLOT_V, SLOT_R, ~)
+};
+
+#define ENTRY_V(S, name, params, args) FXP_CAT(name, S),
+#define ENTRY_R(S, type, name, params, args) FXP_CAT(name, S),
+
+/* Indexed by fxp_isa */
+static const struct kernels kernels[FXP_ISA_COUNT] = {
+	{FXP_DISPATCH_LIST(ENTRY_V, ENTRY_R, generic)},
+	{FXP_DISPATCH_LIST(ENTRY_V, ENTRY_R, sse2)},
+	{FXP_DISPATCH_LIST(ENTRY_V, ENTRY_R, avx2)},
+	{FXP_DISPATCH_LIST(ENTRY_V, ENTRY_R, avx512)},
+};
+
+/* ######################### Lazy initialization ############################ */
+
+/* The active table is read and written with relaxed atomics, so that the first
+ * calls can race with each other (and with fxp_isa_select) without undefined
+ * behaviour. No ordering is needed, since the tables are constant. */
+#define LOAD_ACTIVE() __atomic_load_n(&active, __ATOMIC_RELAXED)
+
+static const struct kernels resolver;
+static const struct kernels *active = &resolver;
+
+/* Replace the resolver with the best table, unless some other thread already
+ * did, or selected a table. */
+static const struct kernels *resolve(void)
+{
+	const struct kernels *expected = &resolver;
+
+	__atomic_compare_exchange_n(&active, &expected,
+				    &kernels[fxp_isa_best()], false,
+				    __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+
+	return LOAD_ACTIVE();
+}
+
+#define RESOLVE_V(S, name, params, args)				\
+	static void FXP_CAT(name, S) params				\
+	{								\
+		resolve()->name args;					\
+	}
+
+#define RESOLVE_R(S, type, name, params, args)				\
+	static type FXP_CAT(name, S) params				\
+	{								\
+		return resolve()->name args;				\
+	}
+
+FXP_DISPATCH_LIST(RESOLVE_V, RESOLVE_R, resolve)
+
+static const struct kernels resolver = {
+	FXP_DISPATCH_LIST(ENTRY_V, ENTRY_R, resolve)
+};
+
+/* ########################### Public wrappers ############################## */
+
+#define WRAP_V(S, name, params, args)					\
+	void name params						\
+	{								\
+		LOAD_ACTIVE()->name args;				\
+	}
+
+#define WRAP_R(S, type, name, params, args)				\
+	type name params						\
+	{								\
+		return LOAD_ACTIVE()->name args;			\
+	}
+
+FXP_DISPATCH_LIST(WRAP_V, WRAP_R, ~)
+
+/* ############################ Query functions ############################# */
+
+bool fxp_isa_available(fxp_isa isa)
+{
+	__builtin_cpu_init();
+
+	switch (isa) {
+	case FXP_ISA_GENERIC:
+		return true;
+	case FXP_ISA_SSE2:
+		return __builtin_cpu_supports("sse2");
+	case FXP_ISA_AVX2:
+		return __builtin_cpu_supports("avx2");
+	case FXP_ISA_AVX512:
+		return __builtin_cpu_supports("avx2")
+			&& __builtin_cpu_supports("avx512f")
+			&& __builtin_cpu_supports("avx512bw");
+	default:
+		return false;
+	}
+}
+
+fxp_isa fxp_isa_active(void)
+{
+	return (fxp_isa)(resolve() - kernels);
+}
+
+bool fxp_isa_select(fxp_isa isa)
+{
+	if (!fxp_isa_available(isa))
+		return false;
+
+	__atomic_store_n(&active, &kernels[isa], __ATOMIC_RELAXED);
+	return true;
+}
+
+#else /* FXP_DISPATCH */
+
+#include "simd.h"
+
+/* Instruction set the library was compiled for */
+#if defined(FXP_SIMD_AVX512)
+#define BUILD_ISA FXP_ISA_AVX512
+#elif defined(FXP_SIMD_AVX2)
+#define BUILD_ISA FXP_ISA_AVX2
+#elif defined(FXP_SIMD_SSE2)
+#define BUILD_ISA FXP_ISA_SSE2
+#else
+#define BUILD_ISA FXP_ISA_GENERIC
+#endif
+
+bool fxp_isa_available(fxp_isa isa)
+{
+	return isa == BUILD_ISA;
+}
+
+fxp_isa fxp_isa_active(void)
+{
+	return BUILD_ISA;
+}
+
+bool fxp_isa_select(fxp_isa isa)
+{
+	return fxp_isa_available(isa);
+}
+
+#endif /* FXP_DISPATCH */
+
+fxp_isa fxp_isa_best(void)
+{
+	int isa = FXP_ISA_COUNT - 1;
+
+	while (isa > FXP_ISA_GENERIC && !fxp_isa_available((fxp_isa)isa))
+		isa--;
+
+	return (fxp_isa)isa;
+}
@@ -0,0 +1,216 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Division by Newton-Raphson reciprocals.
+ *
+ * Unsigned division is done by multiplying by a reciprocal of the normalized
+ * divisor. The reciprocal is seeded from a small table and refined with
+ * Newton-Raphson iterations, using only 32x32 => 64 bit multiplications.
+ */
+
+#include <stdint.h>
+
+#define FXP_DECLARATION FXP_DECLARATION_C99_HEADER
+
+#include "fixed_point/fixed_point.h"
+#include "fixed_point/divide.h"
+
+#ifndef FXP_DIV_ACCURACY
+#define FXP_DIV_ACCURACY 2
+#endif
+
+#if FXP_DIV_ACCURACY < 0 || FXP_DIV_ACCURACY > 2
+#error "FXP_DIV_ACCURACY must be 0, 1 or 2"
+#endif
+
+/* One iteration is enough for 16 bit quotients (and the correction step, if
+ * any, is at most one unit). */
+#define ITER_16 1
+#define ITER_32 ((FXP_DIV_ACCURACY >= 1)? 2 : 1)
+#define EXACT (FXP_DIV_ACCURACY >= 2)
+
+/* Bits of the divisor (after the leading one) used to index the seed table */
+#define RECIP_SEED_BITS 7
+
+/* 1/x in Q15 for x in the middle of each interval of [0.5, 1) */
+static const uint16_t recip_seed[1 << RECIP_SEED_BITS] = {
+	65281, 64777, 64281, 63792, 63310, 62836, 62369, 61909,
+	61455, 61008, 60568, 60133, 59705, 59283, 58867, 58457,
+	58053, 57654, 57260, 56872, 56489, 56111, 55738, 55370,
+	55007, 54649, 54295, 53946, 53601, 53261, 52925, 52593,
+	52265, 51942, 51622, 51306, 50995, 50686, 50382, 50081,
+	49784, 49490, 49200, 48913, 48630, 48349, 48072, 47798,
+	47528, 47260, 46995, 46733, 46474, 46218, 45965, 45714,
+	45467, 45222, 44979, 44739, 44502, 44267, 44035, 43805,
+	43577, 43352, 43129, 42908, 42690, 42474, 42260, 42048,
+	41838, 41631, 41425, 41222, 41020, 40820, 40623, 40427,
+	40233, 40041, 39851, 39662, 39476, 39291, 39108, 38926,
+	38746, 38568, 38392, 38217, 38044, 37872, 37702, 37533,
+	37366, 37200, 37036, 36873, 36712, 36552, 36393, 36236,
+	36080, 35926, 35772, 35620, 35470, 35320, 35172, 35026,
+	34880, 34735, 34592, 34450, 34309, 34169, 34031, 33893,
+	33757, 33622, 33487, 33354, 33222, 33091, 32961, 32832,
+};
+
+static inline int recip_clz32(uint32_t x)
+{
+#ifdef __GNUC__
+	return __builtin_clz(x);
+#else
+	int n = 0;
+
+	for (; !(x & 0x80000000u); x <<= 1)
+		n++;
+
+	return n;
+#endif
+}
+
+/*
+ * Reciprocal of a normalized divisor (n >= 2**31), as 2**63/n.
+ *
+ * Each iteration doubles the number of correct bits, starting with about 8.
+ * The result is never greater than the exact value.
+ */
+static inline uint64_t recip_q63(uint32_t n, int iter)
+{
+	uint64_t r = (uint64_t)recip_seed[(n >> (31 - RECIP_SEED_BITS))
+			& ((1 << RECIP_SEED_BITS) - 1)] << 16;
+	int i;
+
+	for (i = 0; i < iter; i++) {
+		/* e = 1 - n*r, in Q31 */
+		int64_t e = (int64_t)(((uint64_t)1 << 63) - n * r) >> 32;
+
+		r += (uint64_t)(((int64_t)r * e) >> 31);
+	}
+
+	return r;
+}
+
+/*
+ * floor(x * 2**f / d), for d != 0, x <= 2**31, and a result that fits in 32
+ * bits.
+ *
+ * The quotient obtained from the reciprocal can be smaller than the exact one
+ * by a few units. If exact is true, it is corrected with the remainder.
+ */
+static inline uint32_t recip_udiv(uint32_t x, uint32_t d, int f, int iter,
+				  int exact)
+{
+	int s = recip_clz32(d);
+	uint64_t r = recip_q63(d << s, iter);
+	uint32_t q = (uint32_t)(((uint64_t)x * r) >> (63 - f - s));
+
+	if (exact) {
+		uint64_t rem = ((uint64_t)x << f) - (uint64_t)q * d;
+
+		for (; rem >= d; rem -= d)
+			q++;
+	}
+
+	return q;
+}
+
+/*
+ * a * 2**f / b, truncated towards zero and saturated to [-lim, lim - 1].
+ */
+static inline int32_t div_sat(int32_t a, int32_t b, int f, uint32_t lim,
+			      int iter)
+{
+	uint32_t ua = (a < 0)? -(uint32_t)a : (uint32_t)a;
+	uint32_t ub = (b < 0)? -(uint32_t)b : (uint32_t)b;
+	int neg = (a < 0) != (b < 0);
+	uint32_t q;
+
+	if (((uint64_t)ua << f) >= (uint64_t)lim * ub)
+		return neg? (int32_t)(-(int64_t)lim) : (int32_t)(lim - 1);
+
+	q = recip_udiv(ua, ub, f, iter, EXACT);
+
+	return neg? (int32_t)(-(int64_t)q) : (int32_t)q;
+}
+
+frac f_div(frac a, frac b)
+{
+	return _frac((frac_base)div_sat(a.v, b.v, FRAC_FBIT,
+					(uint32_t)1 << FRAC_FBIT, ITER_16));
+}
+
+dfrac df_div(dfrac a, dfrac b)
+{
+	return _dfrac(div_sat(a.v, b.v, DFRAC_FBIT, (uint32_t)1 << 31,
+			      ITER_32));
+}
+
+efrac ef_div(efrac a, efrac b)
+{
+	return _efrac(div_sat(a.v, b.v, EFRAC_FBIT, (uint32_t)1 << 31,
+			      ITER_32));
+}
+
+efrac f_recip(frac x)
+{
+	return _efrac(div_sat(FRAC_1_V + 1, x.v, FRAC_FBIT, (uint32_t)1 << 31,
+			      ITER_32));
+}
+
+void f_div_n(frac *dst, const frac *a, const frac *b, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		dst[i] = f_div(a[i], b[i]);
+}
+
+void df_div_n(dfrac *dst, const dfrac *a, const dfrac *b, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		dst[i] = df_div(a[i], b[i]);
+}
+
+void ef_div_n(efrac *dst, const efrac *a, const efrac *b, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		dst[i] = ef_div(a[i], b[i]);
+}
+
+void f_recip_n(efrac *dst, const frac *x, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		dst[i] = f_recip(x[i]);
+}
@@ -0,0 +1,326 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Fast Fourier Transform.
+ */
+
+#include <string.h>
+
+#define FXP_DECLARATION FXP_DECLARATION_C99_HEADER
+
+#include "variant.h"
+
+#include "fixed_point/fixed_point.h"
+#include "fixed_point/fft.h"
+#include "fixed_point/trig.h"
+#include "simd.h"
+
+/* exp(-j*pi*a) as a cfrac, where a is a binary angle (see trig.h). The
+ * magnitude is at most FRAC_MAX_V (instead of 2**15) so that pmaddwd can never
+ * overflow. */
+static cfrac twiddle(frac a)
+{
+	cfrac w;
+	frac s;
+
+	f_sincos(a, &s, &w.re);
+	w.im = f_neg(s);
+
+	return w;
+}
+
+/* The binary angle of k/m of a half turn. Exact for m <= 2**15. */
+static frac turn_frac(size_t k, size_t m)
+{
+	return _frac((frac_base)((k << FRAC_FBIT) / m));
+}
+
+/* The twiddles of the stage with butterflies of span h (h = 1, 2, 4, ...) are
+ * stored at tw[h ... 2h-1]. */
+void fft_init(fft_f *f, cfrac *twiddle_table, size_t n)
+{
+	size_t h, j;
+
+	twiddle_table[0] = twiddle(_frac(0));
+	for (h = 1; h < n; h <<= 1)
+		for (j = 0; j < h; j++)
+			twiddle_table[h + j] = twiddle(turn_frac(j, h));
+
+	f->tw = twiddle_table;
+	f->n = n;
+}
+
+static void bit_reverse(cfrac *x, size_t n)
+{
+	size_t i, j = 0;
+
+	for (i = 1; i < n; i++) {
+		size_t bit = n >> 1;
+
+		for (; j & bit; bit >>= 1)
+			j ^= bit;
+		j ^= bit;
+
+		if (i < j) {
+			cfrac t = x[i];
+
+			x[i] = x[j];
+			x[j] = t;
+		}
+	}
+}
+
+/* Butterfly: a' = (a + w*b)/2, b' = (a - w*b)/2, where w is conjugated for the
+ * inverse transform (s = -1).
+ *
+ * w*b is computed in Q2.30 and halved, and a is converted to the same scale,
+ * so the sums cannot overflow. df_to_f_cr then rounds and saturates. */
+static inline void butterfly(cfrac *a, cfrac *b, cfrac w, int s)
+{
+	dfrac_base t_re = ((dfrac_base)b->re.v * w.re.v
+			   - s * (dfrac_base)b->im.v * w.im.v) >> 1;
+	dfrac_base t_im = (s * (dfrac_base)b->re.v * w.im.v
+			   + (dfrac_base)b->im.v * w.re.v) >> 1;
+	dfrac_base a_re = a->re.v * (1 << (FRAC_FBIT - 1));
+	dfrac_base a_im = a->im.v * (1 << (FRAC_FBIT - 1));
+
+	a->re = df_to_f_cr(_dfrac(a_re + t_re));
+	a->im = df_to_f_cr(_dfrac(a_im + t_im));
+	b->re = df_to_f_cr(_dfrac(a_re - t_re));
+	b->im = df_to_f_cr(_dfrac(a_im - t_im));
+}
+
+/* (a + b)/2 with convergent rounding and saturation. Only a sum of 65535
+ * (eg. 32767 - (-32768)) rounds to a value that does not fit. */
+static inline frac half_cr(int32_t sum)
+{
+	int32_t q = sum >> 1;
+
+	q += sum & q & 1;
+	return _frac((q > FRAC_MAX_V)? FRAC_MAX_V : (frac_base)q);
+}
+
+/* The first two stages only need the twiddles 1 and -j (+j for the inverse),
+ * so they are done together without multiplications. */
+static void first_stages(cfrac *x, size_t n, int s)
+{
+	size_t k;
+
+	for (k = 0; k + 4 <= n; k += 4) {
+		cfrac y0, y1, y2, y3;
+
+		y0.re = half_cr(x[k].re.v + x[k+1].re.v);
+		y0.im = half_cr(x[k].im.v + x[k+1].im.v);
+		y1.re = half_cr(x[k].re.v - x[k+1].re.v);
+		y1.im = half_cr(x[k].im.v - x[k+1].im.v);
+		y2.re = half_cr(x[k+2].re.v + x[k+3].re.v);
+		y2.im = half_cr(x[k+2].im.v + x[k+3].im.v);
+		/* y3 is multiplied by -j*s */
+		y3.im = half_cr(-s * (x[k+2].re.v - x[k+3].re.v));
+		y3.re = half_cr(s * (x[k+2].im.v - x[k+3].im.v));
+
+		x[k].re = half_cr(y0.re.v + y2.re.v);
+		x[k].im = half_cr(y0.im.v + y2.im.v);
+		x[k+2].re = half_cr(y0.re.v - y2.re.v);
+		x[k+2].im = half_cr(y0.im.v - y2.im.v);
+		x[k+1].re = half_cr(y1.re.v + y3.re.v);
+		x[k+1].im = half_cr(y1.im.v + y3.im.v);
+		x[k+3].re = half_cr(y1.re.v - y3.re.v);
+		x[k+3].im = half_cr(y1.im.v - y3.im.v);
+	}
+}
+
+#ifdef FXP_SIMD
+
+/* Two 16 bit values in a 32 bit element (lo is the first in memory) */
+static inline int32_t pair16(int lo, int hi)
+{
+	return (int32_t)(((uint32_t)(uint16_t)hi << 16) | (uint16_t)lo);
+}
+
+/* simd_round_even(x, FRAC_FBIT) without the saturating add: the sums in the
+ * butterflies are below 3 * 2**29, so adding the bias cannot overflow. */
+static inline simd_v round_even15(simd_v x)
+{
+	simd_v odd = SIMD_AND(SIMD_SRAI32(x, FRAC_FBIT), SIMD_SET32(1));
+	simd_v bias = SIMD_ADD32(odd, SIMD_SET32((1 << (FRAC_FBIT - 1)) - 1));
+
+	return SIMD_SRAI32(SIMD_ADD32(x, bias), FRAC_FBIT);
+}
+
+/* SIMD_N32 butterflies at once. The real and imaginary parts of the complex
+ * products come from pmaddwd with (w.re, -s*w.im) and (s*w.im, w.re). */
+static inline void butterfly_simd(cfrac *a, cfrac *b, const cfrac *w,
+				  simd_v ka, simd_v kb)
+{
+	simd_v va = SIMD_LOAD(a), vb = SIMD_LOAD(b), vw = SIMD_LOAD(w);
+	simd_v t_re = SIMD_SRAI32(SIMD_MADD16(vb, SIMD_MULLO16(vw, ka)), 1);
+	simd_v t_im = SIMD_SRAI32(SIMD_MADD16(vb, SIMD_MULLO16(SIMD_SWAP16(vw),
+							       kb)), 1);
+	simd_v a_re = SIMD_SRAI32(SIMD_SLLI32(va, 16), 2);
+	simd_v a_im = SIMD_SRAI32(SIMD_AND(va, SIMD_SET32(pair16(0, -1))), 2);
+
+	SIMD_STORE(a, SIMD_PACKS32_ZIP(
+			round_even15(SIMD_ADD32(a_re, t_re)),
+			round_even15(SIMD_ADD32(a_im, t_im))));
+	SIMD_STORE(b, SIMD_PACKS32_ZIP(
+			round_even15(SIMD_SUB32(a_re, t_re)),
+			round_even15(SIMD_SUB32(a_im, t_im))));
+}
+
+#endif /* FXP_SIMD */
+
+static void fft_run(const fft_f *f, cfrac *x, int s)
+{
+	size_t n = f->n;
+	size_t h, k, j;
+
+#ifdef FXP_SIMD
+	simd_v ka = SIMD_SET32(pair16(1, -s));
+	simd_v kb = SIMD_SET32(pair16(s, 1));
+#endif
+
+	bit_reverse(x, n);
+
+	if (n >= 4) {
+		first_stages(x, n, s);
+		h = 4;
+	} else {
+		h = 1;
+	}
+
+	for (; h < n; h <<= 1) {
+		const cfrac *w = f->tw + h;
+
+		for (k = 0; k < n; k += 2*h) {
+			j = 0;
+#ifdef FXP_SIMD
+			for (; j + SIMD_N32 <= h; j += SIMD_N32)
+				butterfly_simd(x + k + j, x + k + j + h, w + j,
+					       ka, kb);
+#endif
+			for (; j < h; j++)
+				butterfly(x + k + j, x + k + j + h, w[j], s);
+		}
+	}
+}
+
+void fft(const fft_f *f, cfrac *x)
+{
+	fft_run(f, x, 1);
+}
+
+void ifft(const fft_f *f, cfrac *x)
+{
+	fft_run(f, x, -1);
+}
+
+/* ############################### Real FFT ################################## */
+
+void rfft_init(rfft_f *f, cfrac *twiddle_table, size_t n)
+{
+	size_t k;
+
+	fft_init(&f->half, twiddle_table, n/2);
+
+	twiddle_table += FFT_TWIDDLE_LEN(n/2);
+	for (k = 0; k <= n/4; k++)
+		twiddle_table[k] = twiddle(turn_frac(k, n/2));
+
+	f->tw = twiddle_table;
+	f->n = n;
+}
+
+/* Convergent rounding of x >> sh, saturated to a frac. */
+static frac round_sat(int64_t x, int sh)
+{
+	int64_t half = (int64_t)1 << (sh - 1);
+	int64_t rem = x & (2*half - 1);
+	efrac q = {0};
+	int64_t r = x >> sh;
+
+	if (rem > half || (rem == half && (r & 1)))
+		r++;
+
+	q.v = (r > FRAC_MAX_V)? FRAC_MAX_V : ((r < FRAC_MIN_V)? FRAC_MIN_V : r);
+	return ef_to_f(q);
+}
+
+/* One bin of the real FFT from the half size complex FFT Z:
+ *
+ *         X[k] = (A + B + w*(-j)*(A - B)) / 4
+ *
+ * with A = Z[k], B = conj(Z[m-k]) and w = exp(-2*pi*j*k/n). The result has
+ * the same 1/n scale as the complex FFT. */
+static cfrac rfft_bin(cfrac za, cfrac zb, int32_t w_re, int32_t w_im)
+{
+	int32_t s_re = za.re.v + zb.re.v, s_im = za.im.v - zb.im.v;
+	int32_t d_re = za.re.v - zb.re.v, d_im = za.im.v + zb.im.v;
+	cfrac r;
+
+	/* w * (d_im - j*d_re) */
+	r.re = round_sat((int64_t)s_re * (1 << FRAC_FBIT)
+			 + (int64_t)w_re * d_im + (int64_t)w_im * d_re,
+			 FRAC_FBIT + 2);
+	r.im = round_sat((int64_t)s_im * (1 << FRAC_FBIT)
+			 + (int64_t)w_im * d_im - (int64_t)w_re * d_re,
+			 FRAC_FBIT + 2);
+
+	return r;
+}
+
+void rfft(const rfft_f *f, cfrac *out, const frac *in)
+{
+	size_t m = f->n / 2;
+	size_t k;
+
+	/* the pairs of samples are interpreted as complex numbers */
+	if ((const void *)out != (const void *)in)
+		memcpy(out, in, m * sizeof(*out));
+
+	fft(&f->half, out);
+
+	{
+		cfrac z0 = out[0];
+
+		out[0].re = round_sat((int64_t)z0.re.v + z0.im.v, 1);
+		out[0].im = round_sat((int64_t)z0.re.v - z0.im.v, 1);
+	}
+
+	for (k = 1; k <= m/2; k++) {
+		cfrac za = out[k], zb = out[m - k];
+		cfrac w = f->tw[k];
+
+		out[k] = rfft_bin(za, zb, w.re.v, w.im.v);
+		if (k != m - k)
+			out[m - k] = rfft_bin(zb, za, -w.re.v, w.im.v);
+	}
+}
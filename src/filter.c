@@ -0,0 +1,327 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Digital filters.
+ */
+
+#include <string.h>
+
+#define FXP_DECLARATION FXP_DECLARATION_C99_HEADER
+
+#include "variant.h"
+
+#include "fixed_point/fixed_point.h"
+#include "fixed_point/filter.h"
+#include "simd.h"
+#include "reduce.h"
+
+/* ############################### FIR filters ############################### */
+
+void fir_init(fir_f *f, const frac *coef, frac *state, size_t ntaps)
+{
+	int32_t l1 = 0;
+	size_t k;
+
+	for (k = 0; k < ntaps && l1 < -2 * FRAC_MIN_V; k++)
+		l1 += (coef[k].v < 0)? -coef[k].v : coef[k].v;
+
+	f->coef = coef;
+	f->hist = state;
+	f->ntaps = ntaps;
+	f->wide = l1 >= -2 * FRAC_MIN_V;
+	fir_reset(f);
+}
+
+void fir_reset(fir_f *f)
+{
+	memset(f->hist, 0, FIR_STATE_LEN(f->ntaps) * sizeof(*f->hist));
+	f->len = FIR_STATE_LEN(f->ntaps) / 2;
+	f->pos = 0;
+}
+
+#ifdef FXP_SIMD
+/* SIMD_N16 outputs of a filter whose sums fit in 32 bits, for the windows that
+ * start at h[0] ... h[SIMD_N16 - 1]. The window at h[0] belongs to the newest
+ * sample, so it is the last output.
+ *
+ * A dot product per output would end with a horizontal sum, which costs more
+ * than a short filter. Instead, the taps are applied in pairs to all the
+ * outputs: each 32 bit element of the vector loaded from h + k holds the two
+ * samples that taps k and k+1 multiply for an even window, and the vector
+ * loaded from h + k + 1 those for an odd window. An odd number of taps reads
+ * one sample past the last window, which is multiplied by 0. */
+static inline void fir_outputs_simd(const frac *coef, const frac *h,
+				    size_t ntaps, frac *out)
+{
+	simd_v even = SIMD_ZERO(), odd = SIMD_ZERO(), y;
+	size_t k;
+
+	for (k = 0; k < ntaps; k += 2) {
+		uint16_t c0 = (uint16_t)coef[k].v;
+		uint16_t c1 = (k + 1 < ntaps)? (uint16_t)coef[k + 1].v : 0;
+		simd_v c = SIMD_SET32((int32_t)(((uint32_t)c1 << 16) | c0));
+
+		even = SIMD_ADD32(even, SIMD_MADD16(SIMD_LOAD(h + k), c));
+		odd = SIMD_ADD32(odd, SIMD_MADD16(SIMD_LOAD(h + k + 1), c));
+	}
+
+	y = SIMD_PACKS32_ZIP(simd_round_even(even, FRAC_FBIT),
+			     simd_round_even(odd, FRAC_FBIT));
+	SIMD_STORE(out, SIMD_REVERSE16(y));
+}
+
+/* Compute the next SIMD_N16 outputs at once, if the sums fit in 32 bits and the
+ * windows do not wrap around. Returns the number of outputs, or 0.
+ *
+ * Position 0 is the same as len (see FIR_STATE_LEN), so that a group can start
+ * right at the wrap-around. */
+static inline size_t fir_simd(const fir_f *f, const frac *hist, size_t ntaps,
+			      size_t *pos, frac *out, size_t left)
+{
+	size_t p = (*pos == 0)? f->len : *pos;
+
+	if (f->wide || left < SIMD_N16 || p < SIMD_N16)
+		return 0;
+
+	*pos = p - SIMD_N16;
+	fir_outputs_simd(f->coef, hist + *pos, ntaps, out);
+	return SIMD_N16;
+}
+#else
+#define fir_simd(f, hist, ntaps, pos, out, left) 0
+#endif
+
+/* Samples are written at decreasing positions, and also len positions after
+ * that, so hist[pos ... pos+ntaps-1] holds x[n], x[n-1], ... in the same order
+ * as the coefficients.
+ *
+ * This is a macro so that specialized versions with a constant number of taps
+ * can be generated. The compiler can then unroll the dot product. */
+#define MAKE_FIR_RUN(name, ntaps_expr) \
+static void name(fir_f *f, frac *out, const frac *in, size_t n) \
+{ \
+	const size_t ntaps = (ntaps_expr); \
+	const frac *coef = f->coef; \
+	frac *hist = f->hist; \
+	size_t len = f->len; \
+	size_t pos = f->pos; \
+\
+	while (n > 0) { \
+		size_t m = (n < FIR_BLOCK)? n : FIR_BLOCK; \
+		size_t p = pos; \
+		size_t i; \
+\
+		for (i = 0; i < m; i++) { \
+			p = (p == 0)? len - 1 : p - 1; \
+			hist[p] = hist[p + len] = in[i]; \
+		} \
+\
+		for (i = 0; i < m; i++) { \
+			size_t done = fir_simd(f, hist, ntaps, &pos, out + i, \
+					       m - i); \
+			dfrac acc; \
+\
+			if (done > 0) { \
+				i += done - 1; \
+				continue; \
+			} \
+			pos = (pos == 0)? len - 1 : pos - 1; \
+			if (f->wide) \
+				acc = sat_df(f_dot_raw(coef, hist + pos, ntaps)); \
+			else \
+				acc.v = f_dot_raw32(coef, hist + pos, ntaps); \
+\
+			out[i] = df_to_f_cr(acc); \
+		} \
+\
+		in += m; \
+		out += m; \
+		n -= m; \
+	} \
+\
+	f->pos = pos; \
+}
+
+MAKE_FIR_RUN(fir_run_8, 8)
+MAKE_FIR_RUN(fir_run_16, 16)
+MAKE_FIR_RUN(fir_run_32, 32)
+MAKE_FIR_RUN(fir_run_64, 64)
+MAKE_FIR_RUN(fir_run_any, f->ntaps)
+
+void fir_process(fir_f *f, frac *out, const frac *in, size_t n)
+{
+	switch (f->ntaps) {
+	case 8:
+		fir_run_8(f, out, in, n);
+		break;
+	case 16:
+		fir_run_16(f, out, in, n);
+		break;
+	case 32:
+		fir_run_32(f, out, in, n);
+		break;
+	case 64:
+		fir_run_64(f, out, in, n);
+		break;
+	default:
+		fir_run_any(f, out, in, n);
+		break;
+	}
+}
+
+/* ############################# Biquad filters ############################## */
+
+void biquad_init(biquad_f *f, const biquad_coef *coef, dfrac *state,
+		 size_t nstages, size_t nch, int shift)
+{
+	f->coef = coef;
+	f->state = state;
+	f->nstages = nstages;
+	f->nch = nch;
+	f->shift = shift;
+	biquad_reset(f);
+}
+
+void biquad_reset(biquad_f *f)
+{
+	memset(f->state, 0,
+	       BIQUAD_STATE_LEN(f->nstages, f->nch) * sizeof(*f->state));
+}
+
+/* Convergent rounding of acc >> sh, saturated to a frac. The rounding bias is
+ * added with saturation, exactly as in simd_round_even. */
+static inline frac biquad_round(dfrac acc, int sh)
+{
+	dfrac bias = {(1 << (sh - 1)) - 1 + ((acc.v >> sh) & 1)};
+	efrac q = {df_addsat(acc, bias).v >> sh};
+
+	return ef_to_f(q);
+}
+
+/* Run one section over channels [ch0, nch) of a block, one channel at a time.
+ * s1 and s2 point to the state of channel 0. */
+static void biquad_stage_scalar(const biquad_coef *c, dfrac *s1, dfrac *s2,
+				frac *dst, const frac *src, size_t n,
+				size_t nch, size_t ch0, int sh)
+{
+	size_t ch, t;
+
+	for (ch = ch0; ch < nch; ch++) {
+		dfrac z1 = s1[ch], z2 = s2[ch];
+
+		for (t = 0; t < n; t++) {
+			frac x = src[t*nch + ch];
+			frac y = biquad_round(df_addsat(f_mul_df(c->b0, x), z1), sh);
+
+			z1 = df_addsat(df_subsat(f_mul_df(c->b1, x),
+						 f_mul_df(c->a1, y)), z2);
+			z2 = df_subsat(f_mul_df(c->b2, x), f_mul_df(c->a2, y));
+			dst[t*nch + ch] = y;
+		}
+
+		s1[ch] = z1;
+		s2[ch] = z2;
+	}
+}
+
+#ifdef FXP_SIMD
+/* Same as biquad_stage_scalar, but for SIMD_N16 channels at a time. Returns
+ * the number of channels processed. */
+static size_t biquad_stage_simd(const biquad_coef *c, dfrac *s1, dfrac *s2,
+				frac *dst, const frac *src, size_t n,
+				size_t nch, int sh)
+{
+	simd_v b0 = SIMD_SET16(c->b0.v), b1 = SIMD_SET16(c->b1.v);
+	simd_v b2 = SIMD_SET16(c->b2.v);
+	simd_v a1 = SIMD_SET16(c->a1.v), a2 = SIMD_SET16(c->a2.v);
+	size_t ch, t;
+
+	for (ch = 0; ch + SIMD_N16 <= nch; ch += SIMD_N16) {
+		simd_v z1_0 = SIMD_LOAD(s1 + ch);
+		simd_v z1_1 = SIMD_LOAD(s1 + ch + SIMD_N32);
+		simd_v z2_0 = SIMD_LOAD(s2 + ch);
+		simd_v z2_1 = SIMD_LOAD(s2 + ch + SIMD_N32);
+
+		for (t = 0; t < n; t++) {
+			simd_v x = SIMD_LOAD(src + t*nch + ch);
+			simd_v y, p0, p1, q0, q1;
+
+			SIMD_MULW16(x, b0, p0, p1);
+			y = SIMD_PACKS32(
+				simd_round_even(simd_adds32(p0, z1_0), sh),
+				simd_round_even(simd_adds32(p1, z1_1), sh));
+
+			SIMD_MULW16(x, b1, p0, p1);
+			SIMD_MULW16(y, a1, q0, q1);
+			z1_0 = simd_adds32(simd_subs32(p0, q0), z2_0);
+			z1_1 = simd_adds32(simd_subs32(p1, q1), z2_1);
+
+			SIMD_MULW16(x, b2, p0, p1);
+			SIMD_MULW16(y, a2, q0, q1);
+			z2_0 = simd_subs32(p0, q0);
+			z2_1 = simd_subs32(p1, q1);
+
+			SIMD_STORE(dst + t*nch + ch, y);
+		}
+
+		SIMD_STORE(s1 + ch, z1_0);
+		SIMD_STORE(s1 + ch + SIMD_N32, z1_1);
+		SIMD_STORE(s2 + ch, z2_0);
+		SIMD_STORE(s2 + ch + SIMD_N32, z2_1);
+	}
+
+	return ch;
+}
+#endif /* FXP_SIMD */
+
+/* The first section reads from the input and every section writes to the
+ * output, so the following ones filter the output in place. */
+void biquad_process(biquad_f *f, frac *out, const frac *in, size_t n)
+{
+	size_t nch = f->nch;
+	int sh = FRAC_FBIT - f->shift;
+	const frac *src = in;
+	size_t k;
+
+	for (k = 0; k < f->nstages; k++) {
+		dfrac *s1 = f->state + 2*k*nch;
+		dfrac *s2 = s1 + nch;
+		size_t ch0 = 0;
+
+#ifdef FXP_SIMD
+		ch0 = biquad_stage_simd(f->coef + k, s1, s2, out, src, n, nch,
+					sh);
+#endif
+		biquad_stage_scalar(f->coef + k, s1, s2, out, src, n, nch, ch0,
+				    sh);
+		src = out;
+	}
+}
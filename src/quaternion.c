@@ -45,3 +45,126 @@
 
 #include "fixed_point/quaternion.h"
 
+
+#include <stdint.h>
+#include "fixed_point/sqrt.h"
+
+static inline int norm_clz64(uint64_t x)
+{
+#ifdef __GNUC__
+	return __builtin_clzll(x);
+#else
+	int n = 0;
+
+	for (; !(x & ((uint64_t)1 << 63)); x <<= 1)
+		n++;
+
+	return n;
+#endif
+}
+
+/*
+ * Reciprocal of the norm, given the (nonzero) sum of squares s with p
+ * fractional bits (p even).
+ *
+ * s is scaled by a power of 4 into [0.5, 2), where df_rsqrt is exact, and the
+ * power of 2 is moved to the shift: x/norm = (x * y) >> sh.
+ */
+static inline uint32_t rnorm(uint64_t s, int p, int *sh)
+{
+	int g = (30 - (63 - norm_clz64(s))) & ~1;
+	dfrac t = {(dfrac_base)((g >= 0)? s << g : s >> -g)};
+
+	*sh = 30 - (p + g - 30) / 2;
+
+	return (uint32_t)df_rsqrt(t).v;
+}
+
+/* round(x * y / 2**sh), saturated to [min, max]. sh is 0 only when all the
+ * components are a few LSB. */
+static inline int32_t norm_scale(int32_t x, uint32_t y, int sh, int32_t min,
+				 int32_t max)
+{
+	int64_t r = (int64_t)x * y;
+
+	if (sh > 0)
+		r = (r + ((int64_t)1 << (sh - 1))) >> sh;
+
+	return (r > max)? max : ((r < min)? min : (int32_t)r);
+}
+
+quat q_normalize(quat q)
+{
+	uint64_t s = (uint64_t)((int32_t)q.r.v * q.r.v)
+		   + (uint64_t)((int32_t)q.v.x.v * q.v.x.v)
+		   + (uint64_t)((int32_t)q.v.y.v * q.v.y.v)
+		   + (uint64_t)((int32_t)q.v.z.v * q.v.z.v);
+	uint32_t y;
+	int sh;
+
+	if (s == 0)
+		return q;
+
+	y = rnorm(s, 2 * FRAC_FBIT, &sh);
+#define _QNORM(e) q.e.v = (frac_base)norm_scale(q.e.v, y, sh, \
+						FRAC_MIN_V, FRAC_MAX_V)
+	_QNORM(r);
+	_QNORM(v.x);
+	_QNORM(v.y);
+	_QNORM(v.z);
+#undef _QNORM
+
+	return q;
+}
+
+dquat dq_normalize(dquat q)
+{
+	uint64_t sq[4], s;
+	uint32_t y;
+	int i, p = 2 * DFRAC_FBIT, sh;
+
+	sq[0] = (uint64_t)((int64_t)q.r.v * q.r.v);
+	sq[1] = (uint64_t)((int64_t)q.v.x.v * q.v.x.v);
+	sq[2] = (uint64_t)((int64_t)q.v.y.v * q.v.y.v);
+	sq[3] = (uint64_t)((int64_t)q.v.z.v * q.v.z.v);
+
+	/* The exact sum of squares may need 64 bits. Only in that case is it
+	 * reduced by 2 bits, where the truncation is negligible. */
+	for (s = 0, i = 0; i < 4; i++)
+		s += sq[i] >> 2;
+	if (s < ((uint64_t)1 << 61)) {
+		for (s = 0, i = 0; i < 4; i++)
+			s += sq[i];
+	} else {
+		p -= 2;
+	}
+
+	if (s == 0)
+		return q;
+
+	y = rnorm(s, p, &sh);
+#define _QNORM(e) q.e.v = norm_scale(q.e.v, y, sh, DFRAC_MIN_V, DFRAC_MAX_V)
+	_QNORM(r);
+	_QNORM(v.x);
+	_QNORM(v.y);
+	_QNORM(v.z);
+#undef _QNORM
+
+	return q;
+}
+
+void q_normalize_n(quat *dst, const quat *q, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		dst[i] = q_normalize(q[i]);
+}
+
+void dq_normalize_n(dquat *dst, const dquat *q, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		dst[i] = dq_normalize(q[i]);
+}
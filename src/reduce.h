@@ -0,0 +1,133 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Private reduction kernels shared by the array, filter and CORDIC modules.
+ *
+ * These are defined inline so that callers that know the length of the arrays
+ * at compile time get a specialized (and unrolled) version.
+ */
+
+#ifndef FXP_REDUCE_H
+#define FXP_REDUCE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "fixed_point/fixed_point.h"
+#include "simd.h"
+
+/* Saturate a 64 bit sum of products to the range of a dfrac */
+static inline dfrac sat_df(int64_t x)
+{
+	dfrac r = {(x > DFRAC_MAX_V)? DFRAC_MAX_V
+			: ((x < DFRAC_MIN_V)? DFRAC_MIN_V : (dfrac_base)x)};
+
+	return r;
+}
+
+/* pmaddwd adds two adjacent products in 32 bits. This only overflows when all
+ * four operands are -1, and the result is then INT32_MIN, a value that is
+ * otherwise impossible. Those cases are counted separately and each one is
+ * corrected by adding 2**32. */
+static inline int64_t f_dot_raw(const frac *x, const frac *y, size_t n)
+{
+	int64_t sum = 0;
+	size_t i = 0;
+
+#ifdef FXP_SIMD_AVX512
+	{
+		__m512i acc = _mm512_setzero_si512();
+		__m512i wraps = _mm512_setzero_si512();
+		__m512i min = _mm512_set1_epi32(INT32_MIN);
+		__m512i one = _mm512_set1_epi32(1);
+
+		for (; i + 32 <= n; i += 32) {
+			__m512i p = _mm512_madd_epi16(_mm512_loadu_si512(x + i),
+						      _mm512_loadu_si512(y + i));
+			__mmask16 w = _mm512_cmpeq_epi32_mask(p, min);
+
+			acc = _mm512_add_epi64(acc, _mm512_cvtepi32_epi64(
+						_mm512_castsi512_si256(p)));
+			acc = _mm512_add_epi64(acc, _mm512_cvtepi32_epi64(
+						_mm512_extracti64x4_epi64(p, 1)));
+			wraps = _mm512_mask_add_epi32(wraps, w, wraps, one);
+		}
+		sum += _mm512_reduce_add_epi64(acc)
+			+ _mm512_reduce_add_epi32(wraps) * ((int64_t)1 << 32);
+	}
+#endif
+#ifdef FXP_SIMD
+	{
+		simd_v acc = SIMD_ZERO();
+		simd_v wraps = SIMD_ZERO();
+		simd_v min = SIMD_SET32(INT32_MIN);
+
+		for (; i + SIMD_N16 <= n; i += SIMD_N16) {
+			simd_v p = SIMD_MADD16(SIMD_LOAD(x + i), SIMD_LOAD(y + i));
+			simd_v s = SIMD_SRAI32(p, 31);
+
+			acc = SIMD_ADD64(acc, SIMD_UNPACKLO32(p, s));
+			acc = SIMD_ADD64(acc, SIMD_UNPACKHI32(p, s));
+			wraps = SIMD_SUB32(wraps, SIMD_CMPEQ32(p, min));
+		}
+		sum += simd_hsum64(acc)
+			+ (int64_t)simd_hsum32(wraps) * ((int64_t)1 << 32);
+	}
+#endif
+	for (; i < n; i++)
+		sum += f_mul_df(x[i], y[i]).v;
+
+	return sum;
+}
+
+/* Dot product modulo 2**32. Since wrap-around does not affect the final value
+ * of a sum, the result is exact whenever it is known to fit in 32 bits. */
+static inline int32_t f_dot_raw32(const frac *x, const frac *y, size_t n)
+{
+	uint32_t sum = 0;
+	size_t i = 0;
+
+#ifdef FXP_SIMD
+	{
+		simd_v acc = SIMD_ZERO();
+
+		for (; i + SIMD_N16 <= n; i += SIMD_N16)
+			acc = SIMD_ADD32(acc, SIMD_MADD16(SIMD_LOAD(x + i),
+							  SIMD_LOAD(y + i)));
+		sum = (uint32_t)simd_hsum32(acc);
+	}
+#endif
+	for (; i < n; i++)
+		sum += (uint32_t)f_mul_df(x[i], y[i]).v;
+
+	return (int32_t)sum;
+}
+
+#endif /* FXP_REDUCE_H */
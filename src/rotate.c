@@ -0,0 +1,216 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Rotation of many vectors by the same quaternion.
+ *
+ * The quaternion is converted once to a single precision matrix, which is
+ * then applied to every vector as in @ref m3_mul_v. The vector kernels compute
+ * each component with two 16 bit multiply-adds, one for the x and y products
+ * and one for the z product plus the rounding constant. Their sum can take
+ * 33 bits, so it is divided by 2**15 in parts.
+ *
+ * Packed vectors are split into components with byte shuffles when they are
+ * available, and otherwise converted in chunks through a buffer on the stack.
+ */
+
+#define FXP_DECLARATION FXP_DECLARATION_C99_HEADER
+
+#include "variant.h"
+
+#include "fixed_point/fixed_point.h"
+#include "fixed_point/vector.h"
+#include "fixed_point/matrix.h"
+#include "fixed_point/quaternion.h"
+#include "fixed_point/soa.h"
+#include "simd.h"
+
+#ifdef FXP_SIMD
+
+/* Two 16 bit elements, in the order in which they are stored */
+#define ROT_PAIR(lo, hi) \
+	((int32_t)((uint16_t)(lo) | ((uint32_t)(uint16_t)(hi) << 16)))
+
+/* One row of the matrix, as (x, y) and (z, 1) pairs for SIMD_MADD16 */
+typedef struct {
+	simd_v xy, z1;
+} rot_row;
+
+/*
+ * The multiply-add of the x and y products only overflows when both
+ * coefficients and both components are -1, so the kernels are skipped for
+ * the (non-rotation) matrices which have such a row.
+ */
+static int rot_init(rot_row r[3], mat3 m)
+{
+	const vec3 *row[3] = {&m.x, &m.y, &m.z};
+	int k;
+
+	for (k = 0; k < 3; k++) {
+		if (row[k]->x.v == FRAC_MIN_V && row[k]->y.v == FRAC_MIN_V)
+			return 0;
+		r[k].xy = SIMD_SET32(ROT_PAIR(row[k]->x.v, row[k]->y.v));
+		r[k].z1 = SIMD_SET32(ROT_PAIR(row[k]->z.v, 1));
+	}
+
+	return 1;
+}
+
+/* floor((a + b) / 2**15), without overflowing */
+static inline simd_v rot_sum(simd_v a, simd_v b)
+{
+	simd_v mask = SIMD_SET32((1 << FRAC_FBIT) - 1);
+	simd_v carry = SIMD_ADD32(SIMD_AND(a, mask), SIMD_AND(b, mask));
+
+	return SIMD_ADD32(SIMD_ADD32(SIMD_SRAI32(a, FRAC_FBIT),
+				     SIMD_SRAI32(b, FRAC_FBIT)),
+			  SIMD_SRAI32(carry, FRAC_FBIT));
+}
+
+/* Component of the product of a row with the vectors given as (x, y) and
+ * (z, 1/2) pairs, rounded to nearest and saturated */
+static inline simd_v rot_dot(const rot_row *r, simd_v xy0, simd_v xy1,
+			     simd_v zh0, simd_v zh1)
+{
+	return SIMD_PACKS32(rot_sum(SIMD_MADD16(xy0, r->xy),
+				    SIMD_MADD16(zh0, r->z1)),
+			    rot_sum(SIMD_MADD16(xy1, r->xy),
+				    SIMD_MADD16(zh1, r->z1)));
+}
+
+/* Rotate SIMD_N16 vectors, held by components */
+static inline void rot_kernel(const rot_row r[3], simd_v *x, simd_v *y,
+			      simd_v *z)
+{
+	simd_v xy0, xy1, zh0, zh1;
+
+	SIMD_ZIP16(*x, *y, xy0, xy1);
+	SIMD_ZIP16(*z, SIMD_SET16(1 << (FRAC_FBIT - 1)), zh0, zh1);
+	*x = rot_dot(&r[0], xy0, xy1, zh0, zh1);
+	*y = rot_dot(&r[1], xy0, xy1, zh0, zh1);
+	*z = rot_dot(&r[2], xy0, xy1, zh0, zh1);
+}
+
+/* Rotate the vectors of whole registers, return how many were rotated */
+static size_t rot_planes(const rot_row r[3], vec3_soa dst, vec3_soa v,
+			 size_t n)
+{
+	size_t i;
+
+	for (i = 0; i + SIMD_N16 <= n; i += SIMD_N16) {
+		simd_v x = SIMD_LOAD(v.x + i);
+		simd_v y = SIMD_LOAD(v.y + i);
+		simd_v z = SIMD_LOAD(v.z + i);
+
+		rot_kernel(r, &x, &y, &z);
+		SIMD_STORE(dst.x + i, x);
+		SIMD_STORE(dst.y + i, y);
+		SIMD_STORE(dst.z + i, z);
+	}
+
+	return i;
+}
+
+#endif /* FXP_SIMD */
+
+/* Vectors converted at a time by q_rot_n when there are no byte shuffles */
+#define ROT_CHUNK 256
+
+void q_rot_n(vec3 *dst, quat q, const vec3 *v, size_t n)
+{
+	mat3 m = q_to_mat3(q);
+	size_t i = 0;
+
+#if defined(FXP_SIMD_SHUFFLE8)
+	rot_row r[3];
+
+	if (rot_init(r, m)) {
+		for (; i + SIMD_N16 <= n; i += SIMD_N16) {
+			const frac_base *s = &v[i].x.v;
+			frac_base *d = &dst[i].x.v;
+			simd_v x, y, z, a, b, c;
+
+			SIMD_UNZIP3(SIMD_LOAD(s), SIMD_LOAD(s + SIMD_N16),
+				    SIMD_LOAD(s + 2*SIMD_N16), x, y, z, 2);
+			rot_kernel(r, &x, &y, &z);
+			SIMD_ZIP3(x, y, z, a, b, c, 2);
+			SIMD_STORE(d, a);
+			SIMD_STORE(d + SIMD_N16, b);
+			SIMD_STORE(d + 2*SIMD_N16, c);
+		}
+	}
+#elif defined(FXP_SIMD)
+	rot_row r[3];
+	frac plane[3][ROT_CHUNK];
+	vec3_soa c;
+
+	c.x = plane[0];
+	c.y = plane[1];
+	c.z = plane[2];
+	if (rot_init(r, m)) {
+		/* The vectors that do not fill a register are left to the
+		 * scalar loop */
+		while (n - i >= SIMD_N16) {
+			size_t len = (n - i < ROT_CHUNK)? n - i : ROT_CHUNK;
+
+			v_to_soa(c, v + i, len);
+			len = rot_planes(r, c, c, len);
+			v_from_soa(dst + i, c, len);
+			i += len;
+		}
+	}
+#endif
+	for (; i < n; i++)
+		dst[i] = m3_mul_v(m, v[i]);
+}
+
+void q_rot_soa(vec3_soa dst, quat q, vec3_soa v, size_t n)
+{
+	mat3 m = q_to_mat3(q);
+	size_t i = 0;
+
+#ifdef FXP_SIMD
+	rot_row r[3];
+
+	if (rot_init(r, m))
+		i = rot_planes(r, dst, v, n);
+#endif
+	for (; i < n; i++) {
+		vec3 a, b;
+
+		a.x = v.x[i];
+		a.y = v.y[i];
+		a.z = v.z[i];
+		b = m3_mul_v(m, a);
+		dst.x[i] = b.x;
+		dst.y[i] = b.y;
+		dst.z[i] = b.z;
+	}
+}
@@ -0,0 +1,570 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Private helpers for the vectorized kernels.
+ *
+ * This header maps a small set of generic vector operations onto the widest
+ * instruction set enabled at compile time (for example, by means of -mavx2).
+ * Kernels written in terms of these macros are compiled once per instruction
+ * set and must produce exactly the same results as the scalar routines.
+ *
+ * Define FXP_NO_SIMD to disable all vectorized kernels. They are also disabled
+ * in telemetry builds, so that every element goes through the counted scalar
+ * operations.
+ */
+
+#ifndef FXP_SIMD_H
+#define FXP_SIMD_H
+
+#include <stdint.h>
+
+#if !defined(FXP_NO_SIMD) && !defined(FXP_TELEMETRY)
+
+#if defined(__AVX512BW__)
+#define FXP_SIMD_AVX512
+#endif
+
+#if defined(__AVX2__)
+#define FXP_SIMD_AVX2
+#endif
+
+#if defined(__SSE2__)
+#define FXP_SIMD_SSE2
+#endif
+
+#endif /* !FXP_NO_SIMD && !FXP_TELEMETRY */
+
+#if defined(FXP_SIMD_AVX2)
+
+#include <immintrin.h>
+
+typedef __m256i simd_v;
+
+#define SIMD_BYTES 32
+
+#define SIMD_LOAD(p) _mm256_loadu_si256((const __m256i *)(const void *)(p))
+#define SIMD_STORE(p, x) _mm256_storeu_si256((__m256i *)(void *)(p), (x))
+#define SIMD_ZERO() _mm256_setzero_si256()
+#define SIMD_SET16(x) _mm256_set1_epi16(x)
+#define SIMD_SET32(x) _mm256_set1_epi32(x)
+
+#define SIMD_AND _mm256_and_si256
+#define SIMD_ANDNOT _mm256_andnot_si256
+#define SIMD_OR _mm256_or_si256
+#define SIMD_XOR _mm256_xor_si256
+
+#define SIMD_ADD16 _mm256_add_epi16
+#define SIMD_SUB16 _mm256_sub_epi16
+#define SIMD_ADDS16 _mm256_adds_epi16
+#define SIMD_SUBS16 _mm256_subs_epi16
+#define SIMD_CMPEQ16 _mm256_cmpeq_epi16
+#define SIMD_MULLO16 _mm256_mullo_epi16
+#define SIMD_MULHI16 _mm256_mulhi_epi16
+#define SIMD_MULHIU16 _mm256_mulhi_epu16
+#define SIMD_MULHRS16 _mm256_mulhrs_epi16
+#define SIMD_MIN16 _mm256_min_epi16
+#define SIMD_MAX16 _mm256_max_epi16
+#define SIMD_SLLI16 _mm256_slli_epi16
+#define SIMD_SRLI16 _mm256_srli_epi16
+#define SIMD_SRAI16 _mm256_srai_epi16
+#define SIMD_SRL16(x, n) _mm256_srl_epi16((x), _mm_cvtsi32_si128(n))
+
+#define SIMD_ADD32 _mm256_add_epi32
+#define SIMD_SUB32 _mm256_sub_epi32
+#define SIMD_CMPGT32 _mm256_cmpgt_epi32
+#define SIMD_SLLI32 _mm256_slli_epi32
+#define SIMD_SRAI32 _mm256_srai_epi32
+#define SIMD_SLL32(x, n) _mm256_sll_epi32((x), _mm_cvtsi32_si128(n))
+#define SIMD_SRA32(x, n) _mm256_sra_epi32((x), _mm_cvtsi32_si128(n))
+#define SIMD_MULLO32 _mm256_mullo_epi32
+#define SIMD_CMPEQ32 _mm256_cmpeq_epi32
+#define SIMD_MADD16 _mm256_madd_epi16
+#define SIMD_ADD64 _mm256_add_epi64
+#define SIMD_MULU32 _mm256_mul_epu32
+#define SIMD_SLLI64 _mm256_slli_epi64
+#define SIMD_SRLI64 _mm256_srli_epi64
+#define SIMD_SRL64(x, n) _mm256_srl_epi64((x), _mm_cvtsi32_si128(n))
+
+/* Lane order does not matter for these, they are only used for reductions. */
+#define SIMD_UNPACKLO32 _mm256_unpacklo_epi32
+#define SIMD_UNPACKHI32 _mm256_unpackhi_epi32
+
+/* The 256 bit unpack and pack instructions operate on each 128 bit lane
+ * separately, so the lanes must be put back in order. */
+
+#define SIMD_ZIP16(lo, hi, out0, out1) do { \
+	simd_v _l = _mm256_unpacklo_epi16((lo), (hi)); \
+	simd_v _h = _mm256_unpackhi_epi16((lo), (hi)); \
+	(out0) = _mm256_permute2x128_si256(_l, _h, 0x20); \
+	(out1) = _mm256_permute2x128_si256(_l, _h, 0x31); \
+} while (0)
+
+#define SIMD_PACKS32(a, b) \
+	_mm256_permute4x64_epi64(_mm256_packs_epi32((a), (b)), 0xD8)
+
+/* Pack with saturation and interleave: a0 b0 a1 b1 ... */
+#define SIMD_PACKS32_ZIP(a, b) simd_packs32_zip((a), (b))
+static inline __m256i simd_packs32_zip(__m256i a, __m256i b)
+{
+	__m256i p = _mm256_packs_epi32(a, b);
+
+	return _mm256_unpacklo_epi16(p, _mm256_bsrli_epi128(p, 8));
+}
+
+/* Swap adjacent 16 bit elements */
+#define SIMD_SWAP16(x) \
+	_mm256_shufflehi_epi16(_mm256_shufflelo_epi16((x), 0xB1), 0xB1)
+
+/* Reverse the order of the 16 bit elements */
+#define SIMD_REVERSE16(x) _mm256_permute4x64_epi64( \
+	_mm256_shufflehi_epi16(_mm256_shufflelo_epi16((x), 0x1B), 0x1B), 0x1B)
+
+#define SIMD_ZIP32(lo, hi, out0, out1) do { \
+	simd_v _l = _mm256_unpacklo_epi32((lo), (hi)); \
+	simd_v _h = _mm256_unpackhi_epi32((lo), (hi)); \
+	(out0) = _mm256_permute2x128_si256(_l, _h, 0x20); \
+	(out1) = _mm256_permute2x128_si256(_l, _h, 0x31); \
+} while (0)
+
+#define SIMD_UNZIP32(a, b, even, odd) do { \
+	__m256 _a = _mm256_castsi256_ps(a), _b = _mm256_castsi256_ps(b); \
+	(even) = _mm256_permute4x64_epi64( \
+		_mm256_castps_si256(_mm256_shuffle_ps(_a, _b, 0x88)), 0xD8); \
+	(odd) = _mm256_permute4x64_epi64( \
+		_mm256_castps_si256(_mm256_shuffle_ps(_a, _b, 0xDD)), 0xD8); \
+} while (0)
+
+/* Byte shuffles work within each 128 bit lane, so the masks are repeated and
+ * groups of three vectors are rearranged into two independent halves. */
+#define FXP_SIMD_SHUFFLE8
+#define SIMD_SHUFFLE8 _mm256_shuffle_epi8
+#define SIMD_MASK8(M, r, c, e) \
+	_mm256_setr_epi8(SIMD_MASK_BYTES(M, r, c, e), \
+			 SIMD_MASK_BYTES(M, r, c, e))
+
+#define SIMD_LANES3_SPLIT(a, b, c) do { \
+	simd_v _la = (a), _lb = (b), _lc = (c); \
+	(a) = _mm256_permute2x128_si256(_la, _lb, 0x30); \
+	(b) = _mm256_permute2x128_si256(_la, _lc, 0x21); \
+	(c) = _mm256_permute2x128_si256(_lb, _lc, 0x30); \
+} while (0)
+
+#define SIMD_LANES3_JOIN(a, b, c) do { \
+	simd_v _la = (a), _lb = (b), _lc = (c); \
+	(a) = _mm256_permute2x128_si256(_la, _lb, 0x20); \
+	(b) = _mm256_permute2x128_si256(_lc, _la, 0x30); \
+	(c) = _mm256_permute2x128_si256(_lb, _lc, 0x31); \
+} while (0)
+
+/* Floating point. Comparisons yield an integer mask. */
+
+typedef __m256 simd_vf;
+typedef __m256d simd_vd;
+
+#define SIMD_LOADF(p) _mm256_loadu_ps(p)
+#define SIMD_STOREF(p, x) _mm256_storeu_ps((p), (x))
+#define SIMD_SETF(x) _mm256_set1_ps(x)
+#define SIMD_MULF _mm256_mul_ps
+#define SIMD_CMPGEF(a, b) \
+	_mm256_castps_si256(_mm256_cmp_ps((a), (b), _CMP_GE_OQ))
+#define SIMD_ZNANF(a) _mm256_and_ps((a), _mm256_cmp_ps((a), (a), _CMP_ORD_Q))
+#define SIMD_CVTF32 _mm256_cvtps_epi32
+#define SIMD_CVT32F _mm256_cvtepi32_ps
+
+#define SIMD_LOADD(p) _mm256_loadu_pd(p)
+#define SIMD_STORED(p, x) _mm256_storeu_pd((p), (x))
+#define SIMD_SETD(x) _mm256_set1_pd(x)
+#define SIMD_MULD _mm256_mul_pd
+#define SIMD_MIND _mm256_min_pd
+#define SIMD_MAXD _mm256_max_pd
+#define SIMD_ZNAND(a) _mm256_and_pd((a), _mm256_cmp_pd((a), (a), _CMP_ORD_Q))
+
+/* Two vectors of doubles to one of 32 bit integers */
+#define SIMD_CVTD32(a, b) _mm256_inserti128_si256(_mm256_castsi128_si256( \
+		_mm256_cvtpd_epi32(a)), _mm256_cvtpd_epi32(b), 1)
+
+/* 32 bit integers to two vectors of doubles */
+#define SIMD_CVT32D(x, out0, out1) do { \
+	simd_v _x = (x); \
+	(out0) = _mm256_cvtepi32_pd(_mm256_castsi256_si128(_x)); \
+	(out1) = _mm256_cvtepi32_pd(_mm256_extracti128_si256(_x, 1)); \
+} while (0)
+
+#elif defined(FXP_SIMD_SSE2)
+
+#include <emmintrin.h>
+
+typedef __m128i simd_v;
+
+#define SIMD_BYTES 16
+
+#define SIMD_LOAD(p) _mm_loadu_si128((const __m128i *)(const void *)(p))
+#define SIMD_STORE(p, x) _mm_storeu_si128((__m128i *)(void *)(p), (x))
+#define SIMD_ZERO() _mm_setzero_si128()
+#define SIMD_SET16(x) _mm_set1_epi16(x)
+#define SIMD_SET32(x) _mm_set1_epi32(x)
+
+#define SIMD_AND _mm_and_si128
+#define SIMD_ANDNOT _mm_andnot_si128
+#define SIMD_OR _mm_or_si128
+#define SIMD_XOR _mm_xor_si128
+
+#define SIMD_ADD16 _mm_add_epi16
+#define SIMD_SUB16 _mm_sub_epi16
+#define SIMD_ADDS16 _mm_adds_epi16
+#define SIMD_SUBS16 _mm_subs_epi16
+#define SIMD_CMPEQ16 _mm_cmpeq_epi16
+#define SIMD_MULLO16 _mm_mullo_epi16
+#define SIMD_MULHI16 _mm_mulhi_epi16
+#define SIMD_MULHIU16 _mm_mulhi_epu16
+#define SIMD_MIN16 _mm_min_epi16
+#define SIMD_MAX16 _mm_max_epi16
+#define SIMD_SLLI16 _mm_slli_epi16
+#define SIMD_SRLI16 _mm_srli_epi16
+#define SIMD_SRAI16 _mm_srai_epi16
+#define SIMD_SRL16(x, n) _mm_srl_epi16((x), _mm_cvtsi32_si128(n))
+
+#define SIMD_ADD32 _mm_add_epi32
+#define SIMD_SUB32 _mm_sub_epi32
+#define SIMD_CMPGT32 _mm_cmpgt_epi32
+#define SIMD_SLLI32 _mm_slli_epi32
+#define SIMD_SRAI32 _mm_srai_epi32
+#define SIMD_SLL32(x, n) _mm_sll_epi32((x), _mm_cvtsi32_si128(n))
+#define SIMD_SRA32(x, n) _mm_sra_epi32((x), _mm_cvtsi32_si128(n))
+#define SIMD_MULLO32 simd_mullo32
+#define SIMD_CMPEQ32 _mm_cmpeq_epi32
+#define SIMD_MADD16 _mm_madd_epi16
+#define SIMD_ADD64 _mm_add_epi64
+#define SIMD_MULU32 _mm_mul_epu32
+#define SIMD_SLLI64 _mm_slli_epi64
+#define SIMD_SRLI64 _mm_srli_epi64
+#define SIMD_SRL64(x, n) _mm_srl_epi64((x), _mm_cvtsi32_si128(n))
+#define SIMD_UNPACKLO32 _mm_unpacklo_epi32
+#define SIMD_UNPACKHI32 _mm_unpackhi_epi32
+
+/* SSE2 has no 32 bit low multiply, only the 32x32 => 64 bit unsigned one. The
+ * low half of the product does not depend on the signedness. */
+static inline __m128i simd_mullo32(__m128i a, __m128i b)
+{
+	__m128i p02 = _mm_mul_epu32(a, b);
+	__m128i p13 = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(p02, _MM_SHUFFLE(0, 0, 2, 0)),
+				  _mm_shuffle_epi32(p13, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#define SIMD_MULHRS16 _mm_mulhrs_epi16
+#else
+#define SIMD_MULHRS16 simd_mulhrs16
+
+/* Emulation of pmulhrsw: bits 15 to 30 of (a*b + 2**14). The carry out of the
+ * low half happens when it goes from negative to positive. */
+static inline __m128i simd_mulhrs16(__m128i a, __m128i b)
+{
+	__m128i lo = _mm_mullo_epi16(a, b);
+	__m128i hi = _mm_mulhi_epi16(a, b);
+	__m128i lo_r = _mm_add_epi16(lo, _mm_set1_epi16(1 << 14));
+	__m128i carry = _mm_srai_epi16(_mm_andnot_si128(lo_r, lo), 15);
+
+	hi = _mm_sub_epi16(hi, carry);
+	return _mm_or_si128(_mm_slli_epi16(hi, 1), _mm_srli_epi16(lo_r, 15));
+}
+#endif
+
+#define SIMD_ZIP16(lo, hi, out0, out1) do { \
+	(out0) = _mm_unpacklo_epi16((lo), (hi)); \
+	(out1) = _mm_unpackhi_epi16((lo), (hi)); \
+} while (0)
+
+#define SIMD_PACKS32(a, b) _mm_packs_epi32((a), (b))
+
+#define SIMD_PACKS32_ZIP(a, b) simd_packs32_zip((a), (b))
+static inline __m128i simd_packs32_zip(__m128i a, __m128i b)
+{
+	__m128i p = _mm_packs_epi32(a, b);
+
+	return _mm_unpacklo_epi16(p, _mm_srli_si128(p, 8));
+}
+
+#define SIMD_SWAP16(x) _mm_shufflehi_epi16(_mm_shufflelo_epi16((x), 0xB1), 0xB1)
+
+#define SIMD_REVERSE16(x) _mm_shuffle_epi32( \
+	_mm_shufflehi_epi16(_mm_shufflelo_epi16((x), 0x1B), 0x1B), 0x4E)
+
+#define SIMD_ZIP32(lo, hi, out0, out1) do { \
+	(out0) = _mm_unpacklo_epi32((lo), (hi)); \
+	(out1) = _mm_unpackhi_epi32((lo), (hi)); \
+} while (0)
+
+#define SIMD_UNZIP32(a, b, even, odd) do { \
+	__m128 _a = _mm_castsi128_ps(a), _b = _mm_castsi128_ps(b); \
+	(even) = _mm_castps_si128(_mm_shuffle_ps(_a, _b, 0x88)); \
+	(odd) = _mm_castps_si128(_mm_shuffle_ps(_a, _b, 0xDD)); \
+} while (0)
+
+#ifdef __SSSE3__
+#define FXP_SIMD_SHUFFLE8
+#define SIMD_SHUFFLE8 _mm_shuffle_epi8
+#define SIMD_MASK8(M, r, c, e) _mm_setr_epi8(SIMD_MASK_BYTES(M, r, c, e))
+#define SIMD_LANES3_SPLIT(a, b, c) ((void)0)
+#define SIMD_LANES3_JOIN(a, b, c) ((void)0)
+#endif
+
+typedef __m128 simd_vf;
+typedef __m128d simd_vd;
+
+#define SIMD_LOADF(p) _mm_loadu_ps(p)
+#define SIMD_STOREF(p, x) _mm_storeu_ps((p), (x))
+#define SIMD_SETF(x) _mm_set1_ps(x)
+#define SIMD_MULF _mm_mul_ps
+#define SIMD_CMPGEF(a, b) _mm_castps_si128(_mm_cmpge_ps((a), (b)))
+#define SIMD_ZNANF(a) _mm_and_ps((a), _mm_cmpord_ps((a), (a)))
+#define SIMD_CVTF32 _mm_cvtps_epi32
+#define SIMD_CVT32F _mm_cvtepi32_ps
+
+#define SIMD_LOADD(p) _mm_loadu_pd(p)
+#define SIMD_STORED(p, x) _mm_storeu_pd((p), (x))
+#define SIMD_SETD(x) _mm_set1_pd(x)
+#define SIMD_MULD _mm_mul_pd
+#define SIMD_MIND _mm_min_pd
+#define SIMD_MAXD _mm_max_pd
+#define SIMD_ZNAND(a) _mm_and_pd((a), _mm_cmpord_pd((a), (a)))
+
+#define SIMD_CVTD32(a, b) \
+	_mm_unpacklo_epi64(_mm_cvtpd_epi32(a), _mm_cvtpd_epi32(b))
+
+#define SIMD_CVT32D(x, out0, out1) do { \
+	simd_v _x = (x); \
+	(out0) = _mm_cvtepi32_pd(_x); \
+	(out1) = _mm_cvtepi32_pd(_mm_unpackhi_epi64(_x, _x)); \
+} while (0)
+
+#endif
+
+#ifdef SIMD_BYTES
+
+#define FXP_SIMD
+
+#define SIMD_N16 (SIMD_BYTES / 2)	/*!< 16 bit elements per vector */
+#define SIMD_N32 (SIMD_BYTES / 4)	/*!< 32 bit elements per vector */
+#define SIMD_N64 (SIMD_BYTES / 8)	/*!< 64 bit elements per vector */
+
+/**
+ * Sign-extend 16 bit elements to 32 bits.
+ *
+ * The elements of x are split into out0 (first half) and out1 (second half).
+ */
+#define SIMD_EXTEND16(x, out0, out1) do { \
+	simd_v _x = (x); \
+	SIMD_ZIP16(_x, _x, out0, out1); \
+	(out0) = SIMD_SRAI32((out0), 16); \
+	(out1) = SIMD_SRAI32((out1), 16); \
+} while (0)
+
+/**
+ * Narrow 32 bit elements to 16 bits, discarding the upper half (no saturation).
+ */
+#define SIMD_PACK32(a, b) SIMD_PACKS32(SIMD_SRAI32(SIMD_SLLI32((a), 16), 16), \
+				       SIMD_SRAI32(SIMD_SLLI32((b), 16), 16))
+
+/**
+ * Full 16x16 => 32 bit signed product.
+ *
+ * The products are split into out0 (first half) and out1 (second half).
+ */
+#define SIMD_MULW16(a, b, out0, out1) do { \
+	simd_v _a = (a), _b = (b); \
+	SIMD_ZIP16(SIMD_MULLO16(_a, _b), SIMD_MULHI16(_a, _b), out0, out1); \
+} while (0)
+
+/**
+ * Split the even and odd 16 bit elements of a and b (the inverse of
+ * SIMD_ZIP16).
+ */
+#define SIMD_UNZIP16(a, b, even, odd) do { \
+	simd_v _a = (a), _b = (b); \
+	(even) = SIMD_PACK32(_a, _b); \
+	(odd) = SIMD_PACKS32(SIMD_SRAI32(_a, 16), SIMD_SRAI32(_b, 16)); \
+} while (0)
+
+#ifdef FXP_SIMD_SHUFFLE8
+
+/**
+ * The 16 bytes of a shuffle mask, given by M(r, c, e, j) for j = 0..15.
+ */
+#define SIMD_MASK_BYTES(M, r, c, e) \
+	M(r, c, e, 0), M(r, c, e, 1), M(r, c, e, 2), M(r, c, e, 3), \
+	M(r, c, e, 4), M(r, c, e, 5), M(r, c, e, 6), M(r, c, e, 7), \
+	M(r, c, e, 8), M(r, c, e, 9), M(r, c, e, 10), M(r, c, e, 11), \
+	M(r, c, e, 12), M(r, c, e, 13), M(r, c, e, 14), M(r, c, e, 15)
+
+/* Element of a 16 byte group, for e byte elements */
+#define SIMD_EL(e, j) ((j) / (e))
+
+/* Byte j of the mask that takes from input r the elements of component c, for
+ * triples of e byte elements. The result is -128 (clear) for the elements of
+ * other inputs. */
+#define SIMD_UNZIP3_BYTE(r, c, e, j) \
+	((char)((3 * SIMD_EL(e, j) + (c)) / (16 / (e)) == (r) \
+		? ((3 * SIMD_EL(e, j) + (c)) % (16 / (e))) * (e) + (j) % (e) \
+		: -128))
+
+/* Byte j of the mask that puts component c into output r */
+#define SIMD_ZIP3_BYTE(r, c, e, j) \
+	((char)(((r) * (16 / (e)) + SIMD_EL(e, j)) % 3 == (c) \
+		? (((r) * (16 / (e)) + SIMD_EL(e, j)) / 3) * (e) + (j) % (e) \
+		: -128))
+
+/* Component c of three vectors of triples */
+#define SIMD_UNZIP3_C(a, b, c, comp, e) \
+	SIMD_OR(SIMD_OR( \
+		SIMD_SHUFFLE8((a), SIMD_MASK8(SIMD_UNZIP3_BYTE, 0, comp, e)), \
+		SIMD_SHUFFLE8((b), SIMD_MASK8(SIMD_UNZIP3_BYTE, 1, comp, e))), \
+		SIMD_SHUFFLE8((c), SIMD_MASK8(SIMD_UNZIP3_BYTE, 2, comp, e)))
+
+/* Output r of three vectors of components */
+#define SIMD_ZIP3_R(x, y, z, r, e) \
+	SIMD_OR(SIMD_OR( \
+		SIMD_SHUFFLE8((x), SIMD_MASK8(SIMD_ZIP3_BYTE, r, 0, e)), \
+		SIMD_SHUFFLE8((y), SIMD_MASK8(SIMD_ZIP3_BYTE, r, 1, e))), \
+		SIMD_SHUFFLE8((z), SIMD_MASK8(SIMD_ZIP3_BYTE, r, 2, e)))
+
+/**
+ * Split triples of e byte elements (e = 2 or 4) held in a, b and c into their
+ * components.
+ */
+#define SIMD_UNZIP3(a, b, c, x, y, z, e) do { \
+	simd_v _a = (a), _b = (b), _c = (c); \
+	SIMD_LANES3_SPLIT(_a, _b, _c); \
+	(x) = SIMD_UNZIP3_C(_a, _b, _c, 0, e); \
+	(y) = SIMD_UNZIP3_C(_a, _b, _c, 1, e); \
+	(z) = SIMD_UNZIP3_C(_a, _b, _c, 2, e); \
+} while (0)
+
+/**
+ * Interleave three vectors of e byte components into triples (the inverse of
+ * SIMD_UNZIP3).
+ */
+#define SIMD_ZIP3(x, y, z, a, b, c, e) do { \
+	simd_v _x = (x), _y = (y), _z = (z); \
+	(a) = SIMD_ZIP3_R(_x, _y, _z, 0, e); \
+	(b) = SIMD_ZIP3_R(_x, _y, _z, 1, e); \
+	(c) = SIMD_ZIP3_R(_x, _y, _z, 2, e); \
+	SIMD_LANES3_JOIN(a, b, c); \
+} while (0)
+
+#endif /* FXP_SIMD_SHUFFLE8 */
+
+/**
+ * 32 bit addition with saturation.
+ *
+ * Overflow happens when both operands have the same sign and the sign of the
+ * result differs. In that case the result is replaced by INT32_MAX or
+ * INT32_MIN according to the sign of the first operand.
+ */
+static inline simd_v simd_adds32(simd_v a, simd_v b)
+{
+	simd_v s = SIMD_ADD32(a, b);
+	simd_v ovf = SIMD_SRAI32(SIMD_ANDNOT(SIMD_XOR(a, b), SIMD_XOR(a, s)), 31);
+	simd_v sat = SIMD_XOR(SIMD_SRAI32(a, 31), SIMD_SET32(INT32_MAX));
+
+	return SIMD_OR(SIMD_AND(ovf, sat), SIMD_ANDNOT(ovf, s));
+}
+
+/**
+ * 32 bit substraction with saturation.
+ *
+ * Overflow happens when the operands have different signs and the sign of the
+ * result differs from that of the first operand.
+ */
+static inline simd_v simd_subs32(simd_v a, simd_v b)
+{
+	simd_v s = SIMD_SUB32(a, b);
+	simd_v ovf = SIMD_SRAI32(SIMD_AND(SIMD_XOR(a, b), SIMD_XOR(a, s)), 31);
+	simd_v sat = SIMD_XOR(SIMD_SRAI32(a, 31), SIMD_SET32(INT32_MAX));
+
+	return SIMD_OR(SIMD_AND(ovf, sat), SIMD_ANDNOT(ovf, s));
+}
+
+/**
+ * Convergent rounding of x >> sh (sh >= 1).
+ *
+ * Adding (2**(sh-1) - 1) plus the lowest bit of the result rounds up ties only
+ * when the truncated result is odd. The addition saturates so that it cannot
+ * wrap around.
+ */
+static inline simd_v simd_round_even(simd_v x, int sh)
+{
+	simd_v odd = SIMD_AND(SIMD_SRA32(x, sh), SIMD_SET32(1));
+	simd_v bias = SIMD_ADD32(odd, SIMD_SET32((1 << (sh - 1)) - 1));
+
+	return SIMD_SRA32(simd_adds32(x, bias), sh);
+}
+
+/**
+ * Horizontal sum of 64 bit elements.
+ */
+static inline int64_t simd_hsum64(simd_v x)
+{
+	int64_t e[SIMD_BYTES / 8];
+	int64_t s = 0;
+	unsigned int i;
+
+	SIMD_STORE(e, x);
+	for (i = 0; i < SIMD_BYTES / 8; i++)
+		s += e[i];
+
+	return s;
+}
+
+/**
+ * Horizontal sum of 32 bit elements (modulo 2**32).
+ */
+static inline int32_t simd_hsum32(simd_v x)
+{
+#ifdef FXP_SIMD_AVX2
+	__m128i v = _mm_add_epi32(_mm256_castsi256_si128(x),
+				  _mm256_extracti128_si256(x, 1));
+#else
+	__m128i v = x;
+#endif
+
+	v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+	v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+
+	return _mm_cvtsi128_si32(v);
+}
+
+#endif /* SIMD_BYTES */
+
+#endif /* FXP_SIMD_H */
@@ -0,0 +1,201 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Structure-of-arrays vector operations.
+ *
+ * Each operation is done plane by plane with the array routines, so the batch
+ * functions use the same vectorized kernels (and runtime dispatch, if enabled)
+ * as those. Operations with a scalar operand that only have an array version
+ * taking two arrays are fed a tile filled with copies of the scalar.
+ */
+
+#define FXP_DECLARATION FXP_DECLARATION_C99_HEADER
+
+#include <stdint.h>
+#include "fixed_point/fixed_point.h"
+#include "fixed_point/array.h"
+#include "fixed_point/soa.h"
+
+/* Elements of the scalar tiles */
+#define TILE_LEN 256
+
+/* ####################### Function-generating macros ####################### */
+
+/**
+ * Define a container setup function.
+ *
+ * @param	name	Name of the function.
+ * @param	typeV	Type of the container.
+ * @param	typeE	Type of the elements.
+ */
+#define SOA_INIT(name, typeV, typeE) \
+void name(typeV *v, typeE *buf, size_t n) \
+{ \
+	size_t stride = FXP_SOA_STRIDE(typeE, n); \
+	size_t skew = ((uintptr_t)buf % FXP_SOA_ALIGN) / sizeof(typeE); \
+	\
+	v->x = buf + (skew ? FXP_SOA_ALIGN/sizeof(typeE) - skew : 0); \
+	v->y = v->x + stride; \
+	v->z = v->y + stride; \
+}
+
+/**
+ * Same as @ref SOA_INIT, for quaternion containers.
+ */
+#define SOA_INIT4(name, typeQ, typeE) \
+void name(typeQ *q, typeE *buf, size_t n) \
+{ \
+	size_t stride = FXP_SOA_STRIDE(typeE, n); \
+	size_t skew = ((uintptr_t)buf % FXP_SOA_ALIGN) / sizeof(typeE); \
+	\
+	q->r = buf + (skew ? FXP_SOA_ALIGN/sizeof(typeE) - skew : 0); \
+	q->x = q->r + stride; \
+	q->y = q->x + stride; \
+	q->z = q->y + stride; \
+}
+
+/**
+ * Define a batch function with an element-wise operation between two vectors.
+ *
+ * @param	name	Name of the function.
+ * @param	typeR	Type of the output container.
+ * @param	typeA	Type of the first container.
+ * @param	typeB	Type of the second container.
+ * @param	f_n	Array function.
+ */
+#define SOA_OP2(name, typeR, typeA, typeB, f_n) \
+void name(typeR dst, typeA a, typeB b, size_t n) \
+{ \
+	f_n(dst.x, a.x, b.x, n); \
+	f_n(dst.y, a.y, b.y, n); \
+	f_n(dst.z, a.z, b.z, n); \
+}
+
+/**
+ * Define a batch function with an operation between each vector and a scalar,
+ * when the array function takes the scalar as is.
+ *
+ * @see	SOA_OP2
+ */
+#define SOA_OPS(name, typeR, typeA, typeB, f_n) \
+void name(typeR dst, typeA a, typeB b, size_t n) \
+{ \
+	f_n(dst.x, a.x, b, n); \
+	f_n(dst.y, a.y, b, n); \
+	f_n(dst.z, a.z, b, n); \
+}
+
+/**
+ * Same as @ref SOA_OPS, for array functions which take an array instead of
+ * a scalar.
+ */
+#define SOA_OPS_TILE(name, typeR, typeA, typeB, f_n) \
+void name(typeR dst, typeA a, typeB b, size_t n) \
+{ \
+	typeB tile[TILE_LEN]; \
+	size_t i; \
+	\
+	for (i = 0; i < TILE_LEN && i < n; i++) \
+		tile[i] = b; \
+	\
+	for (i = 0; i < n; i += TILE_LEN) { \
+		size_t m = (n - i < TILE_LEN)? n - i : TILE_LEN; \
+		\
+		f_n(dst.x + i, a.x + i, tile, m); \
+		f_n(dst.y + i, a.y + i, tile, m); \
+		f_n(dst.z + i, a.z + i, tile, m); \
+	} \
+}
+
+/**
+ * Define a batch function that applies an operation to all elements.
+ *
+ * @see	SOA_OP2
+ */
+#define SOA_OP1(name, typeR, typeA, f_n) \
+void name(typeR dst, typeA a, size_t n) \
+{ \
+	f_n(dst.x, a.x, n); \
+	f_n(dst.y, a.y, n); \
+	f_n(dst.z, a.z, n); \
+}
+
+/* ############################### Containers ############################### */
+
+SOA_INIT(mvec3_soa_init, mvec3_soa, mfrac)
+SOA_INIT(vec3_soa_init, vec3_soa, frac)
+SOA_INIT(dvec3_soa_init, dvec3_soa, dfrac)
+SOA_INIT(evec3_soa_init, evec3_soa, efrac)
+SOA_INIT4(quat_soa_init, quat_soa, frac)
+SOA_INIT4(dquat_soa_init, dquat_soa, dfrac)
+
+/* ########################## Vector-vector operations ###################### */
+
+SOA_OP2(v_add_soa, vec3_soa, vec3_soa, vec3_soa, f_add_n)
+SOA_OP2(v_sub_soa, vec3_soa, vec3_soa, vec3_soa, f_sub_n)
+SOA_OP2(ev_add_soa, evec3_soa, evec3_soa, evec3_soa, ef_add_n)
+SOA_OP2(ev_sub_soa, evec3_soa, evec3_soa, evec3_soa, ef_sub_n)
+SOA_OP2(dv_add_soa, dvec3_soa, dvec3_soa, dvec3_soa, df_add_n)
+SOA_OP2(dv_addsat_soa, dvec3_soa, dvec3_soa, dvec3_soa, df_addsat_n)
+SOA_OP2(dv_sub_soa, dvec3_soa, dvec3_soa, dvec3_soa, df_sub_n)
+SOA_OP2(v_mvmul_ev_soa, evec3_soa, vec3_soa, mvec3_soa, f_mf_mul_ef_n)
+
+/* ########################## Vector-scalar operations ###################### */
+
+/* ev_imul and v_imul_ev take an int, but the scalar routines they are built on
+ * take an int16_t. */
+SOA_OPS(v_imul_soa, vec3_soa, vec3_soa, int16_t, f_imul_n)
+SOA_OPS(dv_imul_soa, dvec3_soa, dvec3_soa, int16_t, df_imul_n)
+SOA_OPS(ev_imul_soa, evec3_soa, evec3_soa, int, ef_imul_n)
+SOA_OPS(v_idiv_soa, vec3_soa, vec3_soa, int16_t, f_idiv_n)
+SOA_OPS(dv_idiv_soa, dvec3_soa, dvec3_soa, int16_t, df_idiv_n)
+SOA_OPS(ev_idiv_soa, evec3_soa, evec3_soa, int16_t, ef_idiv_n)
+SOA_OPS(v_idivd_soa, vec3_soa, vec3_soa, const idivider *, f_idivd_n)
+SOA_OPS(dv_idivd_soa, dvec3_soa, dvec3_soa, const idivider *, df_idivd_n)
+SOA_OPS(ev_idivd_soa, evec3_soa, evec3_soa, const idivider *, ef_idivd_n)
+SOA_OPS(dv_shiftl_soa, dvec3_soa, dvec3_soa, int8_t, df_shiftl_n)
+SOA_OPS(dv_shiftr_soa, dvec3_soa, dvec3_soa, int8_t, df_shiftr_n)
+SOA_OPS(v_clip_soa, vec3_soa, vec3_soa, frac, f_clip_n)
+SOA_OPS(v_imul_ev_soa, evec3_soa, vec3_soa, int, f_imul_ef_n)
+
+SOA_OPS_TILE(v_efdiv_ev_soa, evec3_soa, vec3_soa, efrac, f_ef_div_n)
+SOA_OPS_TILE(v_fmul_soa, vec3_soa, vec3_soa, frac, f_mul_n)
+SOA_OPS_TILE(v_fmul_dv_soa, dvec3_soa, vec3_soa, frac, f_mul_df_n)
+SOA_OPS_TILE(v_mfmul_ev_soa, evec3_soa, vec3_soa, mfrac, f_mf_mul_ef_n)
+
+/* ############################ Conversions ################################# */
+
+SOA_OP1(ev_to_v_soa, vec3_soa, evec3_soa, ef_to_f_n)
+SOA_OP1(v_to_ev_soa, evec3_soa, vec3_soa, f_to_ef_n)
+SOA_OP1(v_to_dv_soa, dvec3_soa, vec3_soa, f_to_df_n)
+SOA_OP1(dv_to_v_soa, vec3_soa, dvec3_soa, df_to_f_n)
+SOA_OP1(dv_to_v_r_soa, vec3_soa, dvec3_soa, df_to_f_r_n)
+SOA_OP1(dv_to_v_cr_soa, vec3_soa, dvec3_soa, df_to_f_cr_n)
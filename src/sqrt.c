@@ -0,0 +1,269 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Square roots by Newton-Raphson reciprocal square roots.
+ *
+ * The argument is normalized by an even number of bits, so that its square
+ * root is normalized by half of that. 1/sqrt(x) is seeded from a table and
+ * refined with the iteration y' = y * (3 - x*y*y) / 2, which needs no
+ * division. sqrt(x) = x * (1/sqrt(x)) is then rounded exactly by comparing
+ * its square with the argument, and 1/sqrt(x) by comparing the square of the
+ * rounding boundaries with 1/x.
+ */
+
+#include <stdint.h>
+
+#define FXP_DECLARATION FXP_DECLARATION_C99_HEADER
+
+#include "fixed_point/fixed_point.h"
+#include "fixed_point/sqrt.h"
+
+/* One iteration gives about 15 correct bits, two give about 30. */
+#define ITER_16 1
+#define ITER_32 2
+
+/* Bits of the normalized argument used to index the seed table. Since the
+ * argument is in [0.25, 1), only the upper 3/4 of the table is needed. */
+#define RSQRT_SEED_BITS 8
+#define RSQRT_SEED_OFFSET (1 << (RSQRT_SEED_BITS - 2))
+
+/* 1/sqrt(x) in Q15 for x in the middle of each interval of [0.25, 1) */
+static const uint16_t rsqrt_seed[3 * RSQRT_SEED_OFFSET] = {
+	65281, 64781, 64292, 63814, 63347, 62889, 62442, 62004,
+	61575, 61154, 60742, 60339, 59943, 59555, 59175, 58801,
+	58435, 58075, 57722, 57376, 57035, 56700, 56372, 56049,
+	55731, 55419, 55112, 54810, 54513, 54221, 53933, 53650,
+	53371, 53097, 52826, 52560, 52298, 52040, 51785, 51535,
+	51288, 51044, 50804, 50567, 50333, 50103, 49876, 49652,
+	49430, 49212, 48997, 48784, 48574, 48367, 48163, 47961,
+	47761, 47564, 47370, 47178, 46988, 46800, 46615, 46432,
+	46251, 46072, 45895, 45720, 45547, 45376, 45207, 45040,
+	44875, 44711, 44550, 44390, 44232, 44075, 43920, 43767,
+	43615, 43465, 43316, 43169, 43024, 42879, 42737, 42595,
+	42456, 42317, 42180, 42044, 41910, 41776, 41644, 41514,
+	41384, 41256, 41129, 41003, 40878, 40754, 40631, 40510,
+	40390, 40270, 40152, 40035, 39919, 39803, 39689, 39576,
+	39464, 39352, 39242, 39133, 39024, 38916, 38810, 38704,
+	38599, 38494, 38391, 38289, 38187, 38086, 37986, 37887,
+	37788, 37690, 37593, 37497, 37401, 37307, 37213, 37119,
+	37027, 36935, 36843, 36753, 36663, 36573, 36485, 36397,
+	36309, 36222, 36136, 36051, 35966, 35882, 35798, 35715,
+	35632, 35550, 35469, 35388, 35307, 35228, 35148, 35070,
+	34991, 34914, 34837, 34760, 34684, 34608, 34533, 34458,
+	34384, 34310, 34237, 34164, 34092, 34020, 33949, 33878,
+	33807, 33737, 33668, 33599, 33530, 33461, 33393, 33326,
+	33259, 33192, 33126, 33060, 32994, 32929, 32864, 32800,
+};
+
+static inline int sqrt_clz64(uint64_t x)
+{
+#ifdef __GNUC__
+	return __builtin_clzll(x);
+#else
+	int n = 0;
+
+	for (; !(x & ((uint64_t)1 << 63)); x <<= 1)
+		n++;
+
+	return n;
+#endif
+}
+
+/*
+ * Reciprocal square root of a normalized argument (n >= 2**30), as
+ * 2**46/sqrt(n), that is, 1/sqrt(n/2**32) in Q30.
+ *
+ * The result is within a few units of the exact value, and never greater than
+ * 2**31.
+ */
+static inline uint32_t rsqrt_q30(uint32_t n, int iter)
+{
+	uint32_t y = (uint32_t)rsqrt_seed[(n >> (32 - RSQRT_SEED_BITS))
+					  - RSQRT_SEED_OFFSET] << 15;
+	int i;
+
+	for (i = 0; i < iter; i++) {
+		/* e = 3 - n*y*y, in Q30 */
+		uint64_t y2 = ((uint64_t)y * y) >> 30;
+		int64_t e = ((int64_t)3 << 30) - (int64_t)((n * y2) >> 32);
+
+		y = (uint32_t)(((uint64_t)y * (uint64_t)e) >> 31);
+	}
+
+	return y;
+}
+
+/*
+ * round(sqrt(v)), for v < 2**62.
+ *
+ * Only the upper 32 bits of the normalized argument are used for the
+ * approximation, which is then off by a few units at most.
+ */
+static inline uint32_t sqrt_round(uint64_t v, int iter)
+{
+	int k;
+	uint32_t n, r;
+	int64_t d;
+
+	if (v == 0)
+		return 0;
+
+	k = sqrt_clz64(v) & ~1;
+	n = (uint32_t)((v << k) >> 32);
+	r = (uint32_t)(((uint64_t)n * rsqrt_q30(n, iter)) >> (30 + k / 2));
+
+	/* r is rounded iff -r < v - r*r <= r */
+	d = (int64_t)(v - (uint64_t)r * r);
+	while (d > (int64_t)r) {
+		d -= 2 * (int64_t)r + 1;
+		r++;
+	}
+	while (d <= -(int64_t)r) {
+		r--;
+		d += 2 * (int64_t)r + 1;
+	}
+
+	return r;
+}
+
+frac f_sqrt(frac x)
+{
+	if (x.v <= 0)
+		return _frac(0);
+
+	return _frac((frac_base)sqrt_round((uint64_t)x.v << FRAC_FBIT,
+					   ITER_16));
+}
+
+dfrac df_sqrt(dfrac x)
+{
+	if (x.v <= 0)
+		return _dfrac(0);
+
+	return _dfrac((dfrac_base)sqrt_round((uint64_t)x.v << DFRAC_FBIT,
+					     ITER_32));
+}
+
+efrac ef_sqrt(efrac x)
+{
+	if (x.v <= 0)
+		return _efrac(0);
+
+	return _efrac((efrac_base)sqrt_round((uint64_t)x.v << EFRAC_FBIT,
+					     ITER_32));
+}
+
+/* The squares are in Q30, so the root of their sum is already in Q15 */
+frac v_norm(vec3 a)
+{
+	uint64_t s = (uint64_t)f_mul_df(a.x, a.x).v
+		     + (uint64_t)f_mul_df(a.y, a.y).v
+		     + (uint64_t)f_mul_df(a.z, a.z).v;
+	uint32_t r = sqrt_round(s, ITER_16);
+
+	FXP_TM(v_norm, r > FRAC_MAX_V);
+	return _frac((r < FRAC_MAX_V)? (frac_base)r : FRAC_MAX_V);
+}
+
+/*
+ * Compare x * (2r + 1)**2 with 2**92, that is, x * (r + 1/2)**2 with 2**90.
+ * The product has up to 96 bits, so it is split in two 64 bit parts.
+ */
+static inline int rsqrt_above(uint32_t x, uint64_t r)
+{
+	uint64_t a = (2 * r + 1) * (2 * r + 1);
+	uint64_t lo = (a & 0xFFFFFFFFu) * x;
+	uint64_t hi = (a >> 32) * x + (lo >> 32);
+
+	return hi >= ((uint64_t)1 << 60);
+}
+
+dfrac df_rsqrt(dfrac x)
+{
+	int k;
+	uint32_t r, ux = (uint32_t)x.v;
+
+	if (x.v <= (1 << (DFRAC_FBIT - 2)))
+		return _dfrac(DFRAC_MAX_V);
+
+	/* x is in (2**28, 2**31), so k is 0 or 2, and 2**45/sqrt(x) is
+	 * y/2 or y, respectively. */
+	k = sqrt_clz64((uint64_t)ux << 32) & ~1;
+	r = rsqrt_q30(ux << k, ITER_32) >> (1 - k / 2);
+
+	/* r is rounded iff (r - 1/2)**2 < 2**90/x < (r + 1/2)**2 */
+	while (r < DFRAC_MAX_V && !rsqrt_above(ux, r))
+		r++;
+	while (rsqrt_above(ux, r - 1))
+		r--;
+
+	return _dfrac((dfrac_base)r);
+}
+
+void f_sqrt_n(frac *dst, const frac *x, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		dst[i] = f_sqrt(x[i]);
+}
+
+void df_sqrt_n(dfrac *dst, const dfrac *x, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		dst[i] = df_sqrt(x[i]);
+}
+
+void ef_sqrt_n(efrac *dst, const efrac *x, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		dst[i] = ef_sqrt(x[i]);
+}
+
+void df_rsqrt_n(dfrac *dst, const dfrac *x, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		dst[i] = df_rsqrt(x[i]);
+}
+
+void v_norm_n(frac *dst, const vec3 *a, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		dst[i] = v_norm(a[i]);
+}
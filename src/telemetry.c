@@ -0,0 +1,87 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Saturation and overflow telemetry counters.
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "fixed_point/telemetry.h"
+
+#define NAME_(name, kind) #name,
+#define KIND_(name, kind) FXP_TM_##kind,
+
+static const char *const op_names[FXP_TM_COUNT] = {
+	FXP_TM_LIST(NAME_)
+};
+
+static const fxp_tm_kind op_kinds[FXP_TM_COUNT] = {
+	FXP_TM_LIST(KIND_)
+};
+
+const char *fxp_tm_name(fxp_tm_op op)
+{
+	return ((unsigned)op < FXP_TM_COUNT) ? op_names[op] : NULL;
+}
+
+fxp_tm_kind fxp_tm_kind_of(fxp_tm_op op)
+{
+	return ((unsigned)op < FXP_TM_COUNT) ? op_kinds[op] : FXP_TM_OVERFLOW;
+}
+
+#ifdef FXP_TELEMETRY
+
+FXP_THREAD_LOCAL fxp_telemetry fxp_tm_counters;
+
+bool fxp_telemetry_snapshot(fxp_telemetry *t)
+{
+	*t = fxp_tm_counters;
+	return true;
+}
+
+void fxp_telemetry_reset(void)
+{
+	memset(&fxp_tm_counters, 0, sizeof(fxp_tm_counters));
+}
+
+#else
+
+bool fxp_telemetry_snapshot(fxp_telemetry *t)
+{
+	memset(t, 0, sizeof(*t));
+	return false;
+}
+
+void fxp_telemetry_reset(void)
+{
+}
+
+#endif /* FXP_TELEMETRY */
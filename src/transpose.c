@@ -0,0 +1,253 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Conversion between packed vectors or quaternions and planar components.
+ *
+ * The 16 and 32 bit components are handled by the same routines. Quaternions
+ * are split with two rounds of even/odd deinterleaving, which only need SSE2.
+ * Vectors need byte shuffles (SSSE3 or AVX2), without them the portable code
+ * is used.
+ */
+
+#define FXP_DECLARATION FXP_DECLARATION_C99_HEADER
+
+#include "variant.h"
+
+#include "fixed_point/fixed_point.h"
+#include "fixed_point/quaternion_types.h"
+#include "fixed_point/soa.h"
+#include "simd.h"
+
+typedef char mvec3_is_packed[(sizeof(mvec3) == 3 * sizeof(mfrac))? 1 : -1];
+typedef char vec3_is_packed[(sizeof(vec3) == 3 * sizeof(frac))? 1 : -1];
+typedef char dvec3_is_packed[(sizeof(dvec3) == 3 * sizeof(dfrac))? 1 : -1];
+typedef char evec3_is_packed[(sizeof(evec3) == 3 * sizeof(efrac))? 1 : -1];
+typedef char quat_is_packed[(sizeof(quat) == 4 * sizeof(frac))? 1 : -1];
+typedef char dquat_is_packed[(sizeof(dquat) == 4 * sizeof(dfrac))? 1 : -1];
+
+/* ####################### Function-generating macros ####################### */
+
+/* Loops over whole vector registers. The bodies contain commas, so they are
+ * passed as variable arguments. */
+#ifdef FXP_SIMD
+#define SIMD_LOOP(N, ...) for (; i + (N) <= n; i += (N)) __VA_ARGS__
+#else
+#define SIMD_LOOP(N, ...)
+#endif
+
+#ifdef FXP_SIMD_SHUFFLE8
+#define SHUFFLE_LOOP SIMD_LOOP
+#else
+#define SHUFFLE_LOOP(N, ...)
+#endif
+
+/**
+ * Define the conversions of triples of elements of type T.
+ *
+ * @param	T	Type of the elements, int16_t or int32_t.
+ * @param	N	Elements per vector register.
+ * @param	e	Size of the elements, in bytes.
+ */
+#define TRIPLES(T, N, e) \
+static void unzip3_##e(T *x, T *y, T *z, const T *s, size_t n) \
+{ \
+	size_t i = 0; \
+	\
+	SHUFFLE_LOOP(N, { \
+		simd_v vx, vy, vz; \
+		\
+		SIMD_UNZIP3(SIMD_LOAD(s + 3*i), SIMD_LOAD(s + 3*i + (N)), \
+			    SIMD_LOAD(s + 3*i + 2*(N)), vx, vy, vz, e); \
+		SIMD_STORE(x + i, vx); \
+		SIMD_STORE(y + i, vy); \
+		SIMD_STORE(z + i, vz); \
+	}) \
+	for (; i < n; i++) { \
+		x[i] = s[3*i]; \
+		y[i] = s[3*i + 1]; \
+		z[i] = s[3*i + 2]; \
+	} \
+} \
+\
+static void zip3_##e(T *d, const T *x, const T *y, const T *z, size_t n) \
+{ \
+	size_t i = 0; \
+	\
+	SHUFFLE_LOOP(N, { \
+		simd_v va, vb, vc; \
+		\
+		SIMD_ZIP3(SIMD_LOAD(x + i), SIMD_LOAD(y + i), \
+			  SIMD_LOAD(z + i), va, vb, vc, e); \
+		SIMD_STORE(d + 3*i, va); \
+		SIMD_STORE(d + 3*i + (N), vb); \
+		SIMD_STORE(d + 3*i + 2*(N), vc); \
+	}) \
+	for (; i < n; i++) { \
+		d[3*i] = x[i]; \
+		d[3*i + 1] = y[i]; \
+		d[3*i + 2] = z[i]; \
+	} \
+}
+
+/**
+ * Define the conversions of groups of four elements of type T.
+ *
+ * Each round of UNZIP splits even and odd elements, so two of them take
+ * r x y z r x y z ... to r r ..., y y ... and x x ..., z z ...
+ *
+ * @param	T	Type of the elements, int16_t or int32_t.
+ * @param	N	Elements per vector register.
+ * @param	e	Size of the elements, in bytes.
+ * @param	UNZIP	SIMD_UNZIP16 or SIMD_UNZIP32.
+ * @param	ZIP	SIMD_ZIP16 or SIMD_ZIP32.
+ */
+#define QUADS(T, N, e, UNZIP, ZIP) \
+static void unzip4_##e(T *r, T *x, T *y, T *z, const T *s, size_t n) \
+{ \
+	size_t i = 0; \
+	\
+	SIMD_LOOP(N, { \
+		simd_v e0, o0, e1, o1, v0, v1; \
+		\
+		UNZIP(SIMD_LOAD(s + 4*i), SIMD_LOAD(s + 4*i + (N)), e0, o0); \
+		UNZIP(SIMD_LOAD(s + 4*i + 2*(N)), SIMD_LOAD(s + 4*i + 3*(N)), \
+		      e1, o1); \
+		UNZIP(e0, e1, v0, v1); \
+		SIMD_STORE(r + i, v0); \
+		SIMD_STORE(y + i, v1); \
+		UNZIP(o0, o1, v0, v1); \
+		SIMD_STORE(x + i, v0); \
+		SIMD_STORE(z + i, v1); \
+	}) \
+	for (; i < n; i++) { \
+		r[i] = s[4*i]; \
+		x[i] = s[4*i + 1]; \
+		y[i] = s[4*i + 2]; \
+		z[i] = s[4*i + 3]; \
+	} \
+} \
+\
+static void zip4_##e(T *d, const T *r, const T *x, const T *y, const T *z, \
+		     size_t n) \
+{ \
+	size_t i = 0; \
+	\
+	SIMD_LOOP(N, { \
+		simd_v e0, o0, e1, o1, v0, v1; \
+		\
+		ZIP(SIMD_LOAD(r + i), SIMD_LOAD(y + i), e0, e1); \
+		ZIP(SIMD_LOAD(x + i), SIMD_LOAD(z + i), o0, o1); \
+		ZIP(e0, o0, v0, v1); \
+		SIMD_STORE(d + 4*i, v0); \
+		SIMD_STORE(d + 4*i + (N), v1); \
+		ZIP(e1, o1, v0, v1); \
+		SIMD_STORE(d + 4*i + 2*(N), v0); \
+		SIMD_STORE(d + 4*i + 3*(N), v1); \
+	}) \
+	for (; i < n; i++) { \
+		d[4*i] = r[i]; \
+		d[4*i + 1] = x[i]; \
+		d[4*i + 2] = y[i]; \
+		d[4*i + 3] = z[i]; \
+	} \
+}
+
+
+/* ############################ Raw conversions ############################# */
+
+TRIPLES(int16_t, SIMD_N16, 2)
+TRIPLES(int32_t, SIMD_N32, 4)
+QUADS(int16_t, SIMD_N16, 2, SIMD_UNZIP16, SIMD_ZIP16)
+QUADS(int32_t, SIMD_N32, 4, SIMD_UNZIP32, SIMD_ZIP32)
+
+/* ############################### Vectors ################################## */
+
+void mv_to_soa(mvec3_soa dst, const mvec3 *src, size_t n)
+{
+	unzip3_2(&dst.x->v, &dst.y->v, &dst.z->v, &src->x.v, n);
+}
+
+void mv_from_soa(mvec3 *dst, mvec3_soa src, size_t n)
+{
+	zip3_2(&dst->x.v, &src.x->v, &src.y->v, &src.z->v, n);
+}
+
+void v_to_soa(vec3_soa dst, const vec3 *src, size_t n)
+{
+	unzip3_2(&dst.x->v, &dst.y->v, &dst.z->v, &src->x.v, n);
+}
+
+void v_from_soa(vec3 *dst, vec3_soa src, size_t n)
+{
+	zip3_2(&dst->x.v, &src.x->v, &src.y->v, &src.z->v, n);
+}
+
+void dv_to_soa(dvec3_soa dst, const dvec3 *src, size_t n)
+{
+	unzip3_4(&dst.x->v, &dst.y->v, &dst.z->v, &src->x.v, n);
+}
+
+void dv_from_soa(dvec3 *dst, dvec3_soa src, size_t n)
+{
+	zip3_4(&dst->x.v, &src.x->v, &src.y->v, &src.z->v, n);
+}
+
+void ev_to_soa(evec3_soa dst, const evec3 *src, size_t n)
+{
+	unzip3_4(&dst.x->v, &dst.y->v, &dst.z->v, &src->x.v, n);
+}
+
+void ev_from_soa(evec3 *dst, evec3_soa src, size_t n)
+{
+	zip3_4(&dst->x.v, &src.x->v, &src.y->v, &src.z->v, n);
+}
+
+/* ############################# Quaternions ################################ */
+
+void q_to_soa(quat_soa dst, const quat *src, size_t n)
+{
+	unzip4_2(&dst.r->v, &dst.x->v, &dst.y->v, &dst.z->v, &src->r.v, n);
+}
+
+void q_from_soa(quat *dst, quat_soa src, size_t n)
+{
+	zip4_2(&dst->r.v, &src.r->v, &src.x->v, &src.y->v, &src.z->v, n);
+}
+
+void dq_to_soa(dquat_soa dst, const dquat *src, size_t n)
+{
+	unzip4_4(&dst.r->v, &dst.x->v, &dst.y->v, &dst.z->v, &src->r.v, n);
+}
+
+void dq_from_soa(dquat *dst, dquat_soa src, size_t n)
+{
+	zip4_4(&dst->r.v, &src.r->v, &src.x->v, &src.y->v, &src.z->v, n);
+}
@@ -0,0 +1,223 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Table based sine and cosine.
+ */
+
+#include <stdint.h>
+
+#define FXP_DECLARATION FXP_DECLARATION_C99_HEADER
+
+#include "fixed_point/fixed_point.h"
+#include "fixed_point/trig.h"
+
+#ifndef FXP_TRIG_BITS
+#define FXP_TRIG_BITS 6
+#endif
+
+#if FXP_TRIG_BITS < 3 || FXP_TRIG_BITS > 14
+#error "FXP_TRIG_BITS must be between 3 and 14"
+#endif
+
+/* Binary angles have 14 bits per quadrant. */
+#define QUADRANT_BITS 14
+#define TRIG_N (1 << FXP_TRIG_BITS)
+#define TRIG_SHIFT (QUADRANT_BITS - FXP_TRIG_BITS)
+#define TRIG_HALF ((1 << TRIG_SHIFT) >> 1)
+
+/* Nearest table entry, with ties to even. This makes the entry for the
+ * complementary angle (2**14 - p) be the mirror of the entry for p, so that
+ * the sine of one is exactly the cosine of the other. */
+#if TRIG_SHIFT > 0
+#define TRIG_INDEX(p) \
+	(((p) + TRIG_HALF - 1 + (((p) >> TRIG_SHIFT) & 1)) >> TRIG_SHIFT)
+#else
+#define TRIG_INDEX(p) (p)
+#endif
+
+/* The table is computed by the compiler, with the Taylor series of the sine
+ * (up to x**15, which is exact to double precision in [0, pi/2]). */
+#define HALF_PI 1.57079632679489661923
+
+#define SIN_X2(x2) (1 - (x2)/110*(1 - (x2)/156*(1 - (x2)/210)))
+#define SIN_X1(x2) (1 - (x2)/20*(1 - (x2)/42*(1 - (x2)/72*SIN_X2(x2))))
+#define SIN_X(x, x2) ((x)*(1 - (x2)/6*SIN_X1(x2)))
+#define SIN_ENTRY_X(x) \
+	(uint16_t)(SIN_X(x, (x)*(x)) * (1 << FRAC_FBIT) + 0.5)
+#define SIN_ENTRY(i) SIN_ENTRY_X((i) * (HALF_PI / TRIG_N))
+
+/* SIN_TABLE_b(i) expands to the 2**b entries starting at i. */
+#define SIN_TABLE_0(i) SIN_ENTRY(i),
+#define SIN_TABLE_1(i) SIN_TABLE_0(i) SIN_TABLE_0((i) + 1)
+#define SIN_TABLE_2(i) SIN_TABLE_1(i) SIN_TABLE_1((i) + 2)
+#define SIN_TABLE_3(i) SIN_TABLE_2(i) SIN_TABLE_2((i) + 4)
+#define SIN_TABLE_4(i) SIN_TABLE_3(i) SIN_TABLE_3((i) + 8)
+#define SIN_TABLE_5(i) SIN_TABLE_4(i) SIN_TABLE_4((i) + 16)
+#define SIN_TABLE_6(i) SIN_TABLE_5(i) SIN_TABLE_5((i) + 32)
+#define SIN_TABLE_7(i) SIN_TABLE_6(i) SIN_TABLE_6((i) + 64)
+#define SIN_TABLE_8(i) SIN_TABLE_7(i) SIN_TABLE_7((i) + 128)
+#define SIN_TABLE_9(i) SIN_TABLE_8(i) SIN_TABLE_8((i) + 256)
+#define SIN_TABLE_10(i) SIN_TABLE_9(i) SIN_TABLE_9((i) + 512)
+#define SIN_TABLE_11(i) SIN_TABLE_10(i) SIN_TABLE_10((i) + 1024)
+#define SIN_TABLE_12(i) SIN_TABLE_11(i) SIN_TABLE_11((i) + 2048)
+#define SIN_TABLE_13(i) SIN_TABLE_12(i) SIN_TABLE_12((i) + 4096)
+#define SIN_TABLE_14(i) SIN_TABLE_13(i) SIN_TABLE_13((i) + 8192)
+
+#define SIN_TABLE__(b) SIN_TABLE_ ## b
+#define SIN_TABLE_(b) SIN_TABLE__(b)
+
+/* sin(i*pi/2 / TRIG_N) * 2**15, for i = 0 ... TRIG_N. The entries are
+ * unsigned so that the last one, 2**15, is exact. Only the results, not the
+ * entries, saturate to FRAC_MAX_V. */
+static const uint16_t sin_table[TRIG_N + 1] = {
+	SIN_TABLE_(FXP_TRIG_BITS)(0)
+	SIN_ENTRY(TRIG_N)
+};
+
+/* pi * 2**13, to convert angle differences to radians in Q18 */
+#define PI_Q13 25736
+
+/*
+ * a0*cos(d) + a1*sin(d), where a0, a1 are table entries (or their negatives)
+ * and d is the difference between the angle and the table entry, in units of
+ * 2**-15 * pi radians. |d| <= 2**(TRIG_SHIFT - 1) <= 1024.
+ *
+ * The result is in Q2.30.
+ */
+static inline int32_t sin_expand(int32_t a0, int32_t a1, int32_t d)
+{
+	/* d in Q18 radians, rounded symmetrically */
+	int32_t d18 = (d < 0)? -((-d * PI_Q13 + (1 << 9)) >> 10)
+			     : (d * PI_Q13 + (1 << 9)) >> 10;
+	int32_t h18 = (d18 * d18 + (1 << 18)) >> 19;		/* 1 - cos(d) */
+	int32_t s18 = d18 - (d18 * h18) / (3 << 18);		/* sin(d) */
+
+	return a0 * (1 << 15) + ((a1 * s18 - a0 * h18) >> 3);
+}
+
+static inline frac round_q30(int32_t x)
+{
+	return ef_to_f(_efrac((x + (1 << 14)) >> 15));
+}
+
+/* Sine and cosine of the angle p in the first quadrant (p <= 2**14) */
+static inline void sincos_q(uint_fast16_t p, frac *s, frac *c)
+{
+	int32_t i = TRIG_INDEX(p);
+	int32_t d = (int32_t)p - (i << TRIG_SHIFT);
+	int32_t s0 = sin_table[i], c0 = sin_table[TRIG_N - i];
+
+	*s = round_q30(sin_expand(s0, c0, d));
+	*c = round_q30(sin_expand(c0, -s0, d));
+}
+
+static inline frac sin_q(uint_fast16_t p)
+{
+	int32_t i = TRIG_INDEX(p);
+	int32_t d = (int32_t)p - (i << TRIG_SHIFT);
+
+	return round_q30(sin_expand(sin_table[i], sin_table[TRIG_N - i], d));
+}
+
+/* Reduce to the first quadrant using sin(x + pi/2) = cos(x) and
+ * sin(x + pi) = -sin(x). */
+
+#define QUADRANT(u) ((u) >> QUADRANT_BITS)
+#define QUADRANT_P(u) ((u) & ((1 << QUADRANT_BITS) - 1))
+
+static inline frac sin_u(uint_fast16_t u)
+{
+	uint_fast16_t p = QUADRANT_P(u);
+	frac r = sin_q((QUADRANT(u) & 1)? (1 << QUADRANT_BITS) - p : p);
+
+	return (QUADRANT(u) & 2)? f_neg(r) : r;
+}
+
+frac f_sin(frac a)
+{
+	return sin_u((uint16_t)a.v);
+}
+
+frac f_cos(frac a)
+{
+	return sin_u((uint16_t)(a.v + (1 << QUADRANT_BITS)));
+}
+
+void f_sincos(frac a, frac *s, frac *c)
+{
+	uint_fast16_t u = (uint16_t)a.v;
+	frac sq, cq;
+
+	sincos_q(QUADRANT_P(u), &sq, &cq);
+
+	switch (QUADRANT(u)) {
+	case 0:
+		*s = sq;
+		*c = cq;
+		break;
+	case 1:
+		*s = cq;
+		*c = f_neg(sq);
+		break;
+	case 2:
+		*s = f_neg(sq);
+		*c = f_neg(cq);
+		break;
+	default:
+		*s = f_neg(cq);
+		*c = sq;
+		break;
+	}
+}
+
+void f_sin_n(frac *dst, const frac *a, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		dst[i] = f_sin(a[i]);
+}
+
+void f_cos_n(frac *dst, const frac *a, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		dst[i] = f_cos(a[i]);
+}
+
+void f_sincos_n(frac *s, frac *c, const frac *a, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		f_sincos(a[i], s + i, c + i);
+}
@@ -0,0 +1,447 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * List of the functions selected at run time.
+ *
+ * When the library is built with runtime dispatch (see @ref fxp_dispatch),
+ * the modules listed here are compiled once per instruction set. Each of those
+ * builds defines FXP_DISPATCH_VARIANT to the name of the instruction set and
+ * includes this header before any other, so that every external function gets
+ * the instruction set appended to its name (for example, f_add_n becomes
+ * f_add_n_avx2). src/dispatch.c then defines the public names as thin
+ * wrappers which jump through a table of function pointers.
+ *
+ * FXP_DISPATCH_LIST and the renames below must be kept in sync: a function
+ * missing from the list has no public definition, and a function missing from
+ * the renames is defined by every variant.
+ */
+
+#ifndef FXP_VARIANT_H
+#define FXP_VARIANT_H
+
+#define FXP_CAT_(a, b) a ## _ ## b
+#define FXP_CAT(a, b) FXP_CAT_(a, b)
+
+/**
+ * Apply a macro to every function which is selected at run time.
+ *
+ * V(S, name, params, args) is expanded for functions returning void and
+ * R(S, type, name, params, args) for the rest. S is passed through unchanged.
+ * params is the parenthesized parameter list and args the parenthesized list
+ * of the parameter names.
+ */
+#define FXP_DISPATCH_LIST(V, R, S)					\
+	/* array.h */							\
+	V(S, f_add_n, (frac *dst, const frac *a, const frac *b,		\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, f_sub_n, (frac *dst, const frac *a, const frac *b,		\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, df_add_n, (dfrac *dst, const dfrac *a, const dfrac *b,	\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, df_sub_n, (dfrac *dst, const dfrac *a, const dfrac *b,	\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, ef_add_n, (efrac *dst, const efrac *a, const efrac *b,	\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, ef_sub_n, (efrac *dst, const efrac *a, const efrac *b,	\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, ef_f_add_n, (efrac *dst, const efrac *a, const frac *b,	\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, f_neg_n, (frac *dst, const frac *a, size_t n),		\
+	  (dst, a, n))							\
+	V(S, df_neg_n, (dfrac *dst, const dfrac *a, size_t n),		\
+	  (dst, a, n))							\
+	V(S, ef_neg_n, (efrac *dst, const efrac *a, size_t n),		\
+	  (dst, a, n))							\
+	V(S, f_mul_n, (frac *dst, const frac *a, const frac *b,		\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, f_mul_r_n, (frac *dst, const frac *a, const frac *b,	\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, f_mul_cr_n, (frac *dst, const frac *a, const frac *b,	\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, f_mul_df_n, (dfrac *dst, const frac *a, const frac *b,	\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, f_mf_mul_ef_n, (efrac *dst, const frac *a, const mfrac *b,	\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, f_imul_n, (frac *dst, const frac *a, int16_t b, size_t n),	\
+	  (dst, a, b, n))						\
+	V(S, f_imul_i_n, (int *dst, const frac *a, int b, size_t n),	\
+	  (dst, a, b, n))						\
+	V(S, f_imul_ef_n, (efrac *dst, const frac *a, int16_t b,	\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, df_imul_n, (dfrac *dst, const dfrac *a, int16_t b,		\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, ef_imul_n, (efrac *dst, const efrac *a, int16_t b,		\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, f_idiv_n, (frac *dst, const frac *a, int16_t b, size_t n),	\
+	  (dst, a, b, n))						\
+	V(S, df_idiv_n, (dfrac *dst, const dfrac *a, int16_t b,		\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, ef_idiv_n, (efrac *dst, const efrac *a, int16_t b,		\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, f_idivd_n, (frac *dst, const frac *a, const idivider *d,	\
+	  size_t n),							\
+	  (dst, a, d, n))						\
+	V(S, df_idivd_n, (dfrac *dst, const dfrac *a,			\
+	  const idivider *d, size_t n),					\
+	  (dst, a, d, n))						\
+	V(S, ef_idivd_n, (efrac *dst, const efrac *a,			\
+	  const idivider *d, size_t n),					\
+	  (dst, a, d, n))						\
+	V(S, v_idivd_n, (vec3 *dst, const vec3 *a, const idivider *d,	\
+	  size_t n),							\
+	  (dst, a, d, n))						\
+	V(S, dv_idivd_n, (dvec3 *dst, const dvec3 *a,			\
+	  const idivider *d, size_t n),					\
+	  (dst, a, d, n))						\
+	V(S, ev_idivd_n, (evec3 *dst, const evec3 *a,			\
+	  const idivider *d, size_t n),					\
+	  (dst, a, d, n))						\
+	V(S, df_shiftl_n, (dfrac *dst, const dfrac *a, int16_t b,	\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, df_shiftr_n, (dfrac *dst, const dfrac *a, int16_t b,	\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, df_to_f_n, (frac *dst, const dfrac *x, size_t n),		\
+	  (dst, x, n))							\
+	V(S, df_to_f_r_n, (frac *dst, const dfrac *x, size_t n),	\
+	  (dst, x, n))							\
+	V(S, df_to_f_cr_n, (frac *dst, const dfrac *x, size_t n),	\
+	  (dst, x, n))							\
+	V(S, f_to_df_n, (dfrac *dst, const frac *x, size_t n),		\
+	  (dst, x, n))							\
+	V(S, f_to_ef_n, (efrac *dst, const frac *x, size_t n),		\
+	  (dst, x, n))							\
+	V(S, ef_to_f_n, (frac *dst, const efrac *x, size_t n),		\
+	  (dst, x, n))							\
+	V(S, f_ef_div_n, (efrac *dst, const frac *dividend,		\
+	  const efrac *divisor, size_t n),				\
+	  (dst, dividend, divisor, n))					\
+	V(S, f_clip_n, (frac *dst, const frac *x, frac limit,		\
+	  size_t n),							\
+	  (dst, x, limit, n))						\
+	V(S, df_addsat_n, (dfrac *dst, const dfrac *a, const dfrac *b,	\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, df_subsat_n, (dfrac *dst, const dfrac *a, const dfrac *b,	\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, ef_addsat_n, (efrac *dst, const efrac *a, const efrac *b,	\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, ef_subsat_n, (efrac *dst, const efrac *a, const efrac *b,	\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, f_addsat_n, (frac *dst, const frac *a, const frac *b,	\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, f_subsat_n, (frac *dst, const frac *a, const frac *b,	\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, f_negsat_n, (frac *dst, const frac *a, size_t n),		\
+	  (dst, a, n))							\
+	V(S, f_mulsat_n, (frac *dst, const frac *a, const frac *b,	\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, f_macs_df_n, (dfrac *acc, const frac *x, const frac *y,	\
+	  size_t n),							\
+	  (acc, x, y, n))						\
+	V(S, v_dot_df_n, (dfrac *dst, const vec3 *a, const vec3 *b,	\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, v_norm2_df_n, (dfrac *dst, const vec3 *a, size_t n),	\
+	  (dst, a, n))							\
+	V(S, v_cross_n, (vec3 *dst, const vec3 *a, const vec3 *b,	\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	V(S, v_cross_dv_n, (dvec3 *dst, const vec3 *a, const vec3 *b,	\
+	  size_t n),							\
+	  (dst, a, b, n))						\
+	R(S, dfrac, f_dot_df, (const frac *x, const frac *y, size_t n),	\
+	  (x, y, n))							\
+	R(S, dfrac, f_dot_macs_df, (dfrac z, const frac *x,		\
+	  const frac *y, size_t n),					\
+	  (z, x, y, n))							\
+	R(S, lfrac, f_dot_lf, (const frac *x, const frac *y, size_t n),	\
+	  (x, y, n))							\
+	R(S, lfrac, f_dot_mac_lf, (lfrac z, const frac *x,		\
+	  const frac *y, size_t n),					\
+	  (z, x, y, n))							\
+	R(S, lfrac, df_sum_lf, (const dfrac *x, size_t n), (x, n))	\
+	V(S, float_to_f_n, (frac *dst, const float *x, size_t n),	\
+	  (dst, x, n))							\
+	V(S, float_to_df_n, (dfrac *dst, const float *x, size_t n),	\
+	  (dst, x, n))							\
+	V(S, float_to_ef_n, (efrac *dst, const float *x, size_t n),	\
+	  (dst, x, n))							\
+	V(S, double_to_f_n, (frac *dst, const double *x, size_t n),	\
+	  (dst, x, n))							\
+	V(S, double_to_df_n, (dfrac *dst, const double *x, size_t n),	\
+	  (dst, x, n))							\
+	V(S, double_to_ef_n, (efrac *dst, const double *x, size_t n),	\
+	  (dst, x, n))							\
+	V(S, f_to_float_n, (float *dst, const frac *x, size_t n),	\
+	  (dst, x, n))							\
+	V(S, df_to_float_n, (float *dst, const dfrac *x, size_t n),	\
+	  (dst, x, n))							\
+	V(S, ef_to_float_n, (float *dst, const efrac *x, size_t n),	\
+	  (dst, x, n))							\
+	V(S, f_to_double_n, (double *dst, const frac *x, size_t n),	\
+	  (dst, x, n))							\
+	V(S, df_to_double_n, (double *dst, const dfrac *x, size_t n),	\
+	  (dst, x, n))							\
+	V(S, ef_to_double_n, (double *dst, const efrac *x, size_t n),	\
+	  (dst, x, n))							\
+	/* cordic.h */							\
+	R(S, frac, f_atan2, (frac y, frac x), (y, x))			\
+	R(S, frac, f_hypot, (frac x, frac y), (x, y))			\
+	V(S, f_to_polar, (frac x, frac y, frac *r, frac *a),		\
+	  (x, y, r, a))							\
+	V(S, f_from_polar, (frac r, frac a, frac *x, frac *y),		\
+	  (r, a, x, y))							\
+	V(S, f_rotate, (frac *x, frac *y, frac a), (x, y, a))		\
+	R(S, dfrac, df_atan2, (dfrac y, dfrac x), (y, x))		\
+	R(S, dfrac, df_hypot, (dfrac x, dfrac y), (x, y))		\
+	V(S, df_to_polar, (dfrac x, dfrac y, dfrac *r, dfrac *a),	\
+	  (x, y, r, a))							\
+	V(S, df_from_polar, (dfrac r, dfrac a, dfrac *x, dfrac *y),	\
+	  (r, a, x, y))							\
+	V(S, df_rotate, (dfrac *x, dfrac *y, dfrac a), (x, y, a))	\
+	V(S, df_cordic_polar, (dfrac x, dfrac y, dfrac *r, dfrac *a,	\
+	  int iter),							\
+	  (x, y, r, a, iter))						\
+	V(S, df_cordic_rotate, (dfrac *x, dfrac *y, dfrac a, int iter),	\
+	  (x, y, a, iter))						\
+	V(S, f_atan2_n, (frac *dst, const frac *y, const frac *x,	\
+	  size_t n),							\
+	  (dst, y, x, n))						\
+	V(S, f_hypot_n, (frac *dst, const frac *x, const frac *y,	\
+	  size_t n),							\
+	  (dst, x, y, n))						\
+	V(S, f_to_polar_n, (frac *r, frac *a, const frac *x,		\
+	  const frac *y, size_t n),					\
+	  (r, a, x, y, n))						\
+	V(S, f_from_polar_n, (frac *x, frac *y, const frac *r,		\
+	  const frac *a, size_t n),					\
+	  (x, y, r, a, n))						\
+	V(S, f_rotate_n, (frac *x, frac *y, const frac *a, size_t n),	\
+	  (x, y, a, n))							\
+	/* fft.h */							\
+	V(S, fft_init, (fft_f *f, cfrac *twiddle, size_t n),		\
+	  (f, twiddle, n))						\
+	V(S, fft, (const fft_f *f, cfrac *x), (f, x))			\
+	V(S, ifft, (const fft_f *f, cfrac *x), (f, x))			\
+	V(S, rfft_init, (rfft_f *f, cfrac *twiddle, size_t n),		\
+	  (f, twiddle, n))						\
+	V(S, rfft, (const rfft_f *f, cfrac *out, const frac *in),	\
+	  (f, out, in))							\
+	/* filter.h */							\
+	V(S, fir_init, (fir_f *f, const frac *coef, frac *state,	\
+	  size_t ntaps),						\
+	  (f, coef, state, ntaps))					\
+	V(S, fir_reset, (fir_f *f), (f))				\
+	V(S, fir_process, (fir_f *f, frac *out, const frac *in,		\
+	  size_t n),							\
+	  (f, out, in, n))						\
+	V(S, biquad_init, (biquad_f *f, const biquad_coef *coef,	\
+	  dfrac *state, size_t nstages, size_t nch, int shift),		\
+	  (f, coef, state, nstages, nch, shift))			\
+	V(S, biquad_reset, (biquad_f *f), (f))				\
+	V(S, biquad_process, (biquad_f *f, frac *out, const frac *in,	\
+	  size_t n),							\
+	  (f, out, in, n))						\
+	/* soa.h */							\
+	V(S, mv_to_soa, (mvec3_soa dst, const mvec3 *src, size_t n),	\
+	  (dst, src, n))						\
+	V(S, mv_from_soa, (mvec3 *dst, mvec3_soa src, size_t n),	\
+	  (dst, src, n))						\
+	V(S, v_to_soa, (vec3_soa dst, const vec3 *src, size_t n),	\
+	  (dst, src, n))						\
+	V(S, v_from_soa, (vec3 *dst, vec3_soa src, size_t n),		\
+	  (dst, src, n))						\
+	V(S, dv_to_soa, (dvec3_soa dst, const dvec3 *src, size_t n),	\
+	  (dst, src, n))						\
+	V(S, dv_from_soa, (dvec3 *dst, dvec3_soa src, size_t n),	\
+	  (dst, src, n))						\
+	V(S, ev_to_soa, (evec3_soa dst, const evec3 *src, size_t n),	\
+	  (dst, src, n))						\
+	V(S, ev_from_soa, (evec3 *dst, evec3_soa src, size_t n),	\
+	  (dst, src, n))						\
+	V(S, q_to_soa, (quat_soa dst, const quat *src, size_t n),	\
+	  (dst, src, n))						\
+	V(S, q_from_soa, (quat *dst, quat_soa src, size_t n),		\
+	  (dst, src, n))						\
+	V(S, dq_to_soa, (dquat_soa dst, const dquat *src, size_t n),	\
+	  (dst, src, n))						\
+	V(S, dq_from_soa, (dquat *dst, dquat_soa src, size_t n),	\
+	  (dst, src, n))						\
+	V(S, q_rot_soa, (vec3_soa dst, quat q, vec3_soa v, size_t n),	\
+	  (dst, q, v, n))						\
+	/* quaternion.h */						\
+	V(S, q_rot_n, (vec3 *dst, quat q, const vec3 *v, size_t n),	\
+	  (dst, q, v, n))
+
+#ifdef FXP_DISPATCH_VARIANT
+
+#define FXP_VARIANT(name) FXP_CAT(name, FXP_DISPATCH_VARIANT)
+
+#define f_add_n FXP_VARIANT(f_add_n)
+#define f_sub_n FXP_VARIANT(f_sub_n)
+#define df_add_n FXP_VARIANT(df_add_n)
+#define df_sub_n FXP_VARIANT(df_sub_n)
+#define ef_add_n FXP_VARIANT(ef_add_n)
+#define ef_sub_n FXP_VARIANT(ef_sub_n)
+#define ef_f_add_n FXP_VARIANT(ef_f_add_n)
+#define f_neg_n FXP_VARIANT(f_neg_n)
+#define df_neg_n FXP_VARIANT(df_neg_n)
+#define ef_neg_n FXP_VARIANT(ef_neg_n)
+#define f_mul_n FXP_VARIANT(f_mul_n)
+#define f_mul_r_n FXP_VARIANT(f_mul_r_n)
+#define f_mul_cr_n FXP_VARIANT(f_mul_cr_n)
+#define f_mul_df_n FXP_VARIANT(f_mul_df_n)
+#define f_mf_mul_ef_n FXP_VARIANT(f_mf_mul_ef_n)
+#define f_imul_n FXP_VARIANT(f_imul_n)
+#define f_imul_i_n FXP_VARIANT(f_imul_i_n)
+#define f_imul_ef_n FXP_VARIANT(f_imul_ef_n)
+#define df_imul_n FXP_VARIANT(df_imul_n)
+#define ef_imul_n FXP_VARIANT(ef_imul_n)
+#define f_idiv_n FXP_VARIANT(f_idiv_n)
+#define df_idiv_n FXP_VARIANT(df_idiv_n)
+#define ef_idiv_n FXP_VARIANT(ef_idiv_n)
+#define f_idivd_n FXP_VARIANT(f_idivd_n)
+#define df_idivd_n FXP_VARIANT(df_idivd_n)
+#define ef_idivd_n FXP_VARIANT(ef_idivd_n)
+#define v_idivd_n FXP_VARIANT(v_idivd_n)
+#define dv_idivd_n FXP_VARIANT(dv_idivd_n)
+#define ev_idivd_n FXP_VARIANT(ev_idivd_n)
+#define df_shiftl_n FXP_VARIANT(df_shiftl_n)
+#define df_shiftr_n FXP_VARIANT(df_shiftr_n)
+#define df_to_f_n FXP_VARIANT(df_to_f_n)
+#define df_to_f_r_n FXP_VARIANT(df_to_f_r_n)
+#define df_to_f_cr_n FXP_VARIANT(df_to_f_cr_n)
+#define f_to_df_n FXP_VARIANT(f_to_df_n)
+#define f_to_ef_n FXP_VARIANT(f_to_ef_n)
+#define ef_to_f_n FXP_VARIANT(ef_to_f_n)
+#define f_ef_div_n FXP_VARIANT(f_ef_div_n)
+#define f_clip_n FXP_VARIANT(f_clip_n)
+#define df_addsat_n FXP_VARIANT(df_addsat_n)
+#define df_subsat_n FXP_VARIANT(df_subsat_n)
+#define ef_addsat_n FXP_VARIANT(ef_addsat_n)
+#define ef_subsat_n FXP_VARIANT(ef_subsat_n)
+#define f_addsat_n FXP_VARIANT(f_addsat_n)
+#define f_subsat_n FXP_VARIANT(f_subsat_n)
+#define f_negsat_n FXP_VARIANT(f_negsat_n)
+#define f_mulsat_n FXP_VARIANT(f_mulsat_n)
+#define f_macs_df_n FXP_VARIANT(f_macs_df_n)
+#define v_dot_df_n FXP_VARIANT(v_dot_df_n)
+#define v_norm2_df_n FXP_VARIANT(v_norm2_df_n)
+#define v_cross_n FXP_VARIANT(v_cross_n)
+#define v_cross_dv_n FXP_VARIANT(v_cross_dv_n)
+#define f_dot_df FXP_VARIANT(f_dot_df)
+#define f_dot_macs_df FXP_VARIANT(f_dot_macs_df)
+#define f_dot_lf FXP_VARIANT(f_dot_lf)
+#define f_dot_mac_lf FXP_VARIANT(f_dot_mac_lf)
+#define df_sum_lf FXP_VARIANT(df_sum_lf)
+#define float_to_f_n FXP_VARIANT(float_to_f_n)
+#define float_to_df_n FXP_VARIANT(float_to_df_n)
+#define float_to_ef_n FXP_VARIANT(float_to_ef_n)
+#define double_to_f_n FXP_VARIANT(double_to_f_n)
+#define double_to_df_n FXP_VARIANT(double_to_df_n)
+#define double_to_ef_n FXP_VARIANT(double_to_ef_n)
+#define f_to_float_n FXP_VARIANT(f_to_float_n)
+#define df_to_float_n FXP_VARIANT(df_to_float_n)
+#define ef_to_float_n FXP_VARIANT(ef_to_float_n)
+#define f_to_double_n FXP_VARIANT(f_to_double_n)
+#define df_to_double_n FXP_VARIANT(df_to_double_n)
+#define ef_to_double_n FXP_VARIANT(ef_to_double_n)
+#define f_atan2 FXP_VARIANT(f_atan2)
+#define f_hypot FXP_VARIANT(f_hypot)
+#define f_to_polar FXP_VARIANT(f_to_polar)
+#define f_from_polar FXP_VARIANT(f_from_polar)
+#define f_rotate FXP_VARIANT(f_rotate)
+#define df_atan2 FXP_VARIANT(df_atan2)
+#define df_hypot FXP_VARIANT(df_hypot)
+#define df_to_polar FXP_VARIANT(df_to_polar)
+#define df_from_polar FXP_VARIANT(df_from_polar)
+#define df_rotate FXP_VARIANT(df_rotate)
+#define df_cordic_polar FXP_VARIANT(df_cordic_polar)
+#define df_cordic_rotate FXP_VARIANT(df_cordic_rotate)
+#define f_atan2_n FXP_VARIANT(f_atan2_n)
+#define f_hypot_n FXP_VARIANT(f_hypot_n)
+#define f_to_polar_n FXP_VARIANT(f_to_polar_n)
+#define f_from_polar_n FXP_VARIANT(f_from_polar_n)
+#define f_rotate_n FXP_VARIANT(f_rotate_n)
+#define fft_init FXP_VARIANT(fft_init)
+#define fft FXP_VARIANT(fft)
+#define ifft FXP_VARIANT(ifft)
+#define rfft_init FXP_VARIANT(rfft_init)
+#define rfft FXP_VARIANT(rfft)
+#define fir_init FXP_VARIANT(fir_init)
+#define fir_reset FXP_VARIANT(fir_reset)
+#define fir_process FXP_VARIANT(fir_process)
+#define biquad_init FXP_VARIANT(biquad_init)
+#define biquad_reset FXP_VARIANT(biquad_reset)
+#define biquad_process FXP_VARIANT(biquad_process)
+#define mv_to_soa FXP_VARIANT(mv_to_soa)
+#define mv_from_soa FXP_VARIANT(mv_from_soa)
+#define v_to_soa FXP_VARIANT(v_to_soa)
+#define v_from_soa FXP_VARIANT(v_from_soa)
+#define dv_to_soa FXP_VARIANT(dv_to_soa)
+#define dv_from_soa FXP_VARIANT(dv_from_soa)
+#define ev_to_soa FXP_VARIANT(ev_to_soa)
+#define ev_from_soa FXP_VARIANT(ev_from_soa)
+#define q_to_soa FXP_VARIANT(q_to_soa)
+#define q_from_soa FXP_VARIANT(q_from_soa)
+#define dq_to_soa FXP_VARIANT(dq_to_soa)
+#define dq_from_soa FXP_VARIANT(dq_from_soa)
+#define q_rot_soa FXP_VARIANT(q_rot_soa)
+#define q_rot_n FXP_VARIANT(q_rot_n)
+
+#endif /* FXP_DISPATCH_VARIANT */
+
+#endif /* FXP_VARIANT_H */
@@ -0,0 +1,110 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ * ```
+ *
+ * Regression tests for the FFT.
+ *
+ * Each test prints the failing bins and the program exits with a non zero
+ * status if any of them fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "fixed_point/fixed_point.h"
+#include "fixed_point/fft.h"
+
+#define N_MAX 64
+
+static int failures;
+
+/* Check that a bin is within 1 LSB of (re, im). */
+static void check_bin(const char *test, size_t k, cfrac x, int re, int im)
+{
+	if (abs(x.re.v - re) > 1 || abs(x.im.v - im) > 1) {
+		printf("%s: bin %zu is (%d, %d), expected (%d, %d)\n",
+		       test, k, x.re.v, x.im.v, re, im);
+		failures++;
+	}
+}
+
+/* An impulse of +FRAC_MAX_V followed n/2 samples later by one of FRAC_MIN_V.
+ * The first stage then computes 32767 - (-32768), which used to wrap around
+ * when rounded. */
+static void test_full_scale_impulses(size_t n)
+{
+	cfrac tw[FFT_TWIDDLE_LEN(N_MAX)], x[N_MAX];
+	fft_f f;
+	size_t k;
+
+	fft_init(&f, tw, n);
+	for (k = 0; k < n; k++)
+		x[k].re.v = x[k].im.v = 0;
+	x[0].re.v = FRAC_MAX_V;
+	x[n/2].re.v = FRAC_MIN_V;
+	fft(&f, x);
+
+	/* X[k] = (32767 - (-1)**k * 32768) / n */
+	for (k = 0; k < n; k++)
+		check_bin("full_scale_impulses", k, x[k],
+			  (k & 1)? (int)(65535 / n) + 1 : 0, 0);
+}
+
+/* A full scale alternating sequence has all its energy in bin n/2, which
+ * must saturate to FRAC_MAX_V instead of wrapping around. */
+static void test_full_scale_alternating(size_t n)
+{
+	cfrac tw[FFT_TWIDDLE_LEN(N_MAX)], x[N_MAX];
+	fft_f f;
+	size_t k;
+
+	fft_init(&f, tw, n);
+	for (k = 0; k < n; k++) {
+		x[k].re.v = (k & 1)? FRAC_MIN_V : FRAC_MAX_V;
+		x[k].im.v = (k & 1)? FRAC_MAX_V : FRAC_MIN_V;
+	}
+	fft(&f, x);
+
+	for (k = 0; k < n; k++)
+		check_bin("full_scale_alternating", k, x[k],
+			  (k == n/2)? FRAC_MAX_V : 0,
+			  (k == n/2)? FRAC_MIN_V : 0);
+}
+
+int main(void)
+{
+	size_t n;
+
+	for (n = 4; n <= N_MAX; n <<= 1) {
+		test_full_scale_impulses(n);
+		test_full_scale_alternating(n);
+	}
+
+	return failures != 0;
+}
@@ -0,0 +1,169 @@
+/**
+ * @file
+ * @author	Juan I Carrano
+ * @copyright	Copyright (c) 2019 Juan I Carrano
+ * @copyright	All rights reserved.
+ * ```
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of copyright holders nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Accuracy tests for the rotation of vectors by quaternions.
+ *
+ * The results of @ref q_rot and @ref q_rot_n for random unit quaternions and
+ * vectors of norm up to 1 are compared with the exact rotation, and the
+ * program exits with a non zero status if any error exceeds its bound.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "fixed_point/fixed_point.h"
+#include "fixed_point/quaternion.h"
+
+#define N_TESTS 2000
+#define N_VECTORS 53
+
+/* Bounds on the error, in LSB, of each component. */
+#define Q_ROT_N_BOUND 2.0
+#define Q_ROT_BOUND 6.0
+
+static int failures;
+
+static double rnd(void)
+{
+	return 2.0 * rand() / RAND_MAX - 1.0;
+}
+
+static frac to_frac(double x)
+{
+	return _frac((frac_base)lrint(x * 32768.0));
+}
+
+static double from_frac(frac x)
+{
+	return x.v / 32768.0;
+}
+
+/* A random unit quaternion, scaled to stay below 1 after rounding. */
+static quat rnd_quat(void)
+{
+	double c[4], n = 0;
+	quat q;
+	int i;
+
+	for (i = 0; i < 4; i++) {
+		c[i] = rnd();
+		n += c[i] * c[i];
+	}
+	n = 32767.0 / 32768.0 / sqrt(n);
+	q.r = to_frac(c[0] * n);
+	q.v.x = to_frac(c[1] * n);
+	q.v.y = to_frac(c[2] * n);
+	q.v.z = to_frac(c[3] * n);
+	return q;
+}
+
+/* A random vector of norm up to 1. */
+static vec3 rnd_vec3(void)
+{
+	double c[3], n = 0;
+	vec3 v;
+	int i;
+
+	for (i = 0; i < 3; i++) {
+		c[i] = rnd();
+		n += c[i] * c[i];
+	}
+	n = (n > 1.0)? 32767.0 / 32768.0 / sqrt(n) : 32767.0 / 32768.0;
+	v.x = to_frac(c[0] * n);
+	v.y = to_frac(c[1] * n);
+	v.z = to_frac(c[2] * n);
+	return v;
+}
+
+/* q v q* in double precision, that is, v rotated by q and scaled by |q|**2.
+ * The result is in LSB. */
+static void exact_rot(quat q, vec3 v, double r[3])
+{
+	double w = from_frac(q.r), x = from_frac(q.v.x),
+	       y = from_frac(q.v.y), z = from_frac(q.v.z);
+	double a = from_frac(v.x), b = from_frac(v.y), c = from_frac(v.z);
+
+	r[0] = ((w*w + x*x - y*y - z*z) * a + 2 * (x*y - w*z) * b
+		+ 2 * (x*z + w*y) * c) * 32768.0;
+	r[1] = (2 * (x*y + w*z) * a + (w*w - x*x + y*y - z*z) * b
+		+ 2 * (y*z - w*x) * c) * 32768.0;
+	r[2] = (2 * (x*z - w*y) * a + 2 * (y*z + w*x) * b
+		+ (w*w - x*x - y*y + z*z) * c) * 32768.0;
+}
+
+static double max_error(vec3 v, const double r[3])
+{
+	double e = fabs(v.x.v - r[0]);
+
+	e = fmax(e, fabs(v.y.v - r[1]));
+	return fmax(e, fabs(v.z.v - r[2]));
+}
+
+/* Every quaternion rotates an array of vectors, long enough for the vector
+ * code of q_rot_n and with a tail left to the scalar code. */
+static void test_rotation(void)
+{
+	double worst_rot = 0, worst_rot_n = 0;
+	vec3 v[N_VECTORS], b[N_VECTORS];
+	int i, j;
+
+	srand(1);
+	for (i = 0; i < N_TESTS; i++) {
+		quat q = rnd_quat();
+
+		for (j = 0; j < N_VECTORS; j++)
+			v[j] = rnd_vec3();
+		q_rot_n(b, q, v, N_VECTORS);
+
+		for (j = 0; j < N_VECTORS; j++) {
+			vec3 a = q_rot(q, v[j]);
+			double r[3];
+
+			exact_rot(q, v[j], r);
+			worst_rot = fmax(worst_rot, max_error(a, r));
+			worst_rot_n = fmax(worst_rot_n, max_error(b[j], r));
+		}
+	}
+
+	printf("rotation: q_rot %.2f LSB, q_rot_n %.2f LSB\n",
+	       worst_rot, worst_rot_n);
+	if (worst_rot > Q_ROT_BOUND || worst_rot_n > Q_ROT_N_BOUND) {
+		printf("rotation: error above the bound (%.1f, %.1f)\n",
+		       Q_ROT_BOUND, Q_ROT_N_BOUND);
+		failures++;
+	}
+}
+
+int main(void)
+{
+	test_rotation();
+
+	return failures != 0;
+}